@@ -0,0 +1,1147 @@
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_bench.h"
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_simd.h"
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_broadphase.h"
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_field.h"
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_sweep.h"
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_replay.h"
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_headless.h"
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_envs.h"
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_observe.h"
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_mesh.h"
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_view.h"
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_chunks.h"
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_minimap.h"
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_fov.h"
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_quads.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+double BenchSeconds() {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Random float in [lo, hi)
+static float RandomRange(float lo, float hi) {
+    return lo + (hi - lo) * (rand() / (RAND_MAX + 1.0f));
+}
+
+// Enemies per nanosecond for ChaseBatch at every instruction set the CPU has
+static void BenchChase() {
+    const int count = 4096;
+    const int reps = 20000;
+    float *ex = malloc(count * sizeof(float));
+    float *ey = malloc(count * sizeof(float));
+    float *tx = malloc(count * sizeof(float));
+    float *ty = malloc(count * sizeof(float));
+    float *refX = malloc(count * sizeof(float));
+    float *refY = malloc(count * sizeof(float));
+    SimdLevel best = GetSimdLevel();
+
+    for (int level = SIMD_SCALAR; level <= (int)best; level++) {
+        srand(1);
+        for (int i = 0; i < count; i++) {
+            ex[i] = RandomRange(0, 760);
+            ey[i] = RandomRange(0, 760);
+            tx[i] = RandomRange(0, 760);
+            ty[i] = RandomRange(0, 760);
+        }
+
+        SetSimdLevel((SimdLevel)level);
+        double start = BenchSeconds();
+        for (int r = 0; r < reps; r++) {
+            ChaseBatch(ex, ey, tx, ty, count, 2.0f);
+        }
+        double elapsed = BenchSeconds() - start;
+
+        // One step from fresh positions, compared against the scalar loop
+        float maxError = 0;
+        for (int i = 0; i < count; i++) {
+            refX[i] = ex[i] = RandomRange(0, 760);
+            refY[i] = ey[i] = RandomRange(0, 760);
+        }
+        ChaseBatch(ex, ey, tx, ty, count, 2.0f);
+        SetSimdLevel(SIMD_SCALAR);
+        ChaseBatch(refX, refY, tx, ty, count, 2.0f);
+        for (int i = 0; i < count; i++) {
+            maxError = fmaxf(maxError, fmaxf(fabsf(ex[i] - refX[i]), fabsf(ey[i] - refY[i])));
+        }
+
+        printf("chase %-6s %8.3f enemies/ns  max error %g px\n", GetSimdLevelName((SimdLevel)level),
+               (double)count * reps / (elapsed * 1e9), maxError);
+    }
+    SetSimdLevel(best);
+
+    free(ex);
+    free(ey);
+    free(tx);
+    free(ty);
+    free(refX);
+    free(refY);
+}
+
+// Agents per nanosecond for CanMoveBatch on a random 19x19 and 1024x1024 grid
+static void BenchWalls() {
+    const int count = 4096;
+    const int sizes[] = {19, 1024};
+    const float cellSize = 40, radius = 18;
+    float *x = malloc(count * sizeof(float));
+    float *y = malloc(count * sizeof(float));
+    unsigned int *mask = malloc((count / 32) * sizeof(unsigned int));
+    unsigned int *refMask = malloc((count / 32) * sizeof(unsigned int));
+    SimdLevel best = GetSimdLevel();
+
+    for (int s = 0; s < 2; s++) {
+        int size = sizes[s];
+        bool *cells = malloc((size_t)size * size);
+        srand(2);
+        for (int i = 0; i < size * size; i++) cells[i] = rand() % 4 != 0;
+        for (int i = 0; i < count; i++) {
+            x[i] = RandomRange(radius, size * cellSize - radius);
+            y[i] = RandomRange(radius, size * cellSize - radius);
+        }
+        SetSimdLevel(SIMD_SCALAR);
+        CanMoveBatch(cells, size, size, x, y, count, cellSize, radius, refMask);
+
+        for (int level = SIMD_SCALAR; level <= (int)best; level++) {
+            int reps = 5000;
+            SetSimdLevel((SimdLevel)level);
+            double start = BenchSeconds();
+            for (int r = 0; r < reps; r++) {
+                CanMoveBatch(cells, size, size, x, y, count, cellSize, radius, mask);
+            }
+            double elapsed = BenchSeconds() - start;
+            bool same = memcmp(mask, refMask, (count / 32) * sizeof(unsigned int)) == 0;
+
+            printf("walls %4dx%-4d %-6s %8.3f agents/ns  %s\n", size, size, GetSimdLevelName((SimdLevel)level),
+                   (double)count * reps / (elapsed * 1e9), same ? "matches scalar" : "MISMATCH");
+        }
+        free(cells);
+    }
+    SetSimdLevel(best);
+
+    free(x);
+    free(y);
+    free(mask);
+    free(refMask);
+}
+
+// Spatial hash rebuild, neighbour queries and separation at 1k, 10k and 100k entities,
+// against the all-pairs test where that finishes in reasonable time
+static void BenchBroadphase() {
+    const int counts[] = {1000, 10000, 100000};
+    const float cellSize = 40, radius = 40;
+
+    for (int k = 0; k < 3; k++) {
+        int count = counts[k];
+        int side = (int)ceilf(sqrtf(count * 2.0f)); // About one entity per two cells
+        float *x = malloc(count * sizeof(float));
+        float *y = malloc(count * sizeof(float));
+        int *found = malloc(count * sizeof(int));
+        SpatialHash hash;
+
+        srand(3);
+        for (int i = 0; i < count; i++) {
+            x[i] = RandomRange(0, side * cellSize);
+            y[i] = RandomRange(0, side * cellSize);
+        }
+        InitSpatialHash(&hash, side, side, cellSize);
+
+        if (count <= 10000) {
+            long long brutePairs = 0;
+            double start = BenchSeconds();
+            for (int i = 0; i < count; i++) {
+                for (int j = 0; j < count; j++) {
+                    float diffX = x[j] - x[i];
+                    float diffY = y[j] - y[i];
+                    if (diffX * diffX + diffY * diffY <= radius * radius) brutePairs++;
+                }
+            }
+            printf("broadphase %6d entities  all-pairs queries %8.3f ms  (%lld hits)\n",
+                   count, (BenchSeconds() - start) * 1e3, brutePairs);
+        }
+
+        int reps = 20;
+        double start = BenchSeconds();
+        for (int r = 0; r < reps; r++) RebuildSpatialHash(&hash, x, y, count);
+        double rebuild = (BenchSeconds() - start) / reps;
+
+        long long pairs = 0;
+        start = BenchSeconds();
+        for (int i = 0; i < count; i++) {
+            pairs += QuerySpatialHash(&hash, x, y, x[i], y[i], radius, found, count);
+        }
+        double query = BenchSeconds() - start;
+
+        start = BenchSeconds();
+        SeparateEntities(&hash, x, y, radius);
+        double separate = BenchSeconds() - start;
+
+        printf("broadphase %6d entities  rebuild %8.3f ms  queries %8.3f ms  separate %8.3f ms  (%lld hits)\n",
+               count, rebuild * 1e3, query * 1e3, separate * 1e3, pairs);
+
+        FreeSpatialHash(&hash);
+        free(x);
+        free(y);
+        free(found);
+    }
+}
+
+// Random maze-like grid: border walls, path on odd cells, and random links between them
+static void RandomMaze(bool *cells, int width, int height) {
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            bool border = x == 0 || y == 0 || x == width - 1 || y == height - 1;
+            bool room = (x & 1) && (y & 1);
+            bool link = ((x & 1) != (y & 1)) && rand() % 2 == 0;
+            cells[y * width + x] = !border && (room || link);
+        }
+    }
+}
+
+// Distance field rebuild cost per maze size, and the cost of one query against CanMoveBatch
+static void BenchField() {
+    const int sizes[] = {19, 128, 512};
+    const float cellSize = 40, radius = 18;
+    const int queries = 1 << 16;
+    float *x = malloc(queries * sizeof(float));
+    float *y = malloc(queries * sizeof(float));
+    unsigned int *mask = malloc((queries / 32) * sizeof(unsigned int));
+
+    for (int s = 0; s < 3; s++) {
+        int size = sizes[s];
+        bool *cells = malloc((size_t)size * size);
+        DistanceField field = {0};
+        srand(4);
+        RandomMaze(cells, size, size);
+
+        int builds = size < 512 ? 20 : 2;
+        double start = BenchSeconds();
+        for (int b = 0; b < builds; b++) BuildDistanceField(&field, cells, size, size, cellSize, 4);
+        double build = (BenchSeconds() - start) / builds;
+
+        for (int i = 0; i < queries; i++) {
+            x[i] = RandomRange(radius, size * cellSize - radius);
+            y[i] = RandomRange(radius, size * cellSize - radius);
+        }
+        int fits = 0;
+        start = BenchSeconds();
+        for (int r = 0; r < 10; r++) {
+            for (int i = 0; i < queries; i++) fits += CircleFits(&field, x[i], y[i], radius);
+        }
+        double query = (BenchSeconds() - start) / (10.0 * queries);
+
+        start = BenchSeconds();
+        for (int r = 0; r < 10; r++) CanMoveBatch(cells, size, size, x, y, queries, cellSize, radius, mask);
+        double canMove = (BenchSeconds() - start) / (10.0 * queries);
+
+        printf("field %4dx%-4d rebuild %9.3f ms  query %6.2f ns  (CanMoveBatch %5.2f ns/agent, %d fits)\n",
+               size, size, build * 1e3, query * 1e9, canMove * 1e9, fits / 10);
+
+        FreeDistanceField(&field);
+        free(cells);
+    }
+
+    free(x);
+    free(y);
+    free(mask);
+}
+
+// Exact test that a circle does not overlap any wall cell
+static bool CircleClear(const bool *cells, int size, float cellSize, float x, float y, float radius) {
+    int cx = (int)(x / cellSize), cy = (int)(y / cellSize);
+    for (int wy = cy - 1; wy <= cy + 1; wy++) {
+        for (int wx = cx - 1; wx <= cx + 1; wx++) {
+            if (wx < 0 || wy < 0 || wx >= size || wy >= size || cells[wy * size + wx]) continue;
+            float nearX = fminf(fmaxf(x, wx * cellSize), (wx + 1) * cellSize);
+            float nearY = fminf(fmaxf(y, wy * cellSize), (wy + 1) * cellSize);
+            if ((x - nearX) * (x - nearX) + (y - nearY) * (y - nearY) < radius * radius) return false;
+        }
+    }
+    return true;
+}
+
+// Swept moves of growing length through a 64x64 maze: cost per move, and how many end up
+// inside a wall (none should) compared with only testing the end point
+static void BenchSweep() {
+    const int size = 64, moves = 100000;
+    const float cellSize = 40, radius = 18;
+    const float lengths[] = {4, 40, 400};
+    bool *cells = malloc(size * size);
+    float *x = malloc(moves * sizeof(float));
+    float *y = malloc(moves * sizeof(float));
+    float *moveX = malloc(moves * sizeof(float));
+    float *moveY = malloc(moves * sizeof(float));
+
+    srand(5);
+    RandomMaze(cells, size, size);
+
+    for (int l = 0; l < 3; l++) {
+        // Start in the middle of a random room, move in a random direction
+        for (int i = 0; i < moves; i++) {
+            float angle = RandomRange(0, 6.2831853f);
+            x[i] = ((rand() % (size / 2 - 1)) * 2 + 1.5f) * cellSize;
+            y[i] = ((rand() % (size / 2 - 1)) * 2 + 1.5f) * cellSize;
+            moveX[i] = cosf(angle) * lengths[l];
+            moveY[i] = sinf(angle) * lengths[l];
+        }
+
+        // Moving in one step and testing only where it lands can pass straight through a wall
+        int tunnels = 0;
+        for (int i = 0; i < moves; i++) {
+            float endX = x[i] + moveX[i], endY = y[i] + moveY[i], nx, ny;
+            if (CircleClear(cells, size, cellSize, endX, endY, radius) &&
+                SweepCircle(cells, size, size, cellSize, x[i], y[i], moveX[i], moveY[i], radius, &nx, &ny) < 1) tunnels++;
+        }
+
+        double start = BenchSeconds();
+        for (int i = 0; i < moves; i++) {
+            SweepMove(cells, size, size, cellSize, &x[i], &y[i], moveX[i], moveY[i], radius);
+        }
+        double elapsed = BenchSeconds() - start;
+
+        int inWall = 0;
+        for (int i = 0; i < moves; i++) inWall += !CircleClear(cells, size, cellSize, x[i], y[i], radius);
+        printf("sweep move %5.0f px  %8.1f ns/move  ended in a wall %d  (end-point test would tunnel %d)\n",
+               lengths[l], elapsed / moves * 1e9, inWall, tunnels);
+    }
+
+    free(cells);
+    free(x);
+    free(y);
+    free(moveX);
+    free(moveY);
+}
+
+// Many independent games in one process, stepped in turn: ticks per second, memory per game, and
+// a check that every game ends exactly where it does when run on its own
+static void BenchSessions() {
+    const int counts[] = {1, 64, 1024};
+    const long ticks = 2000;
+
+    for (int c = 0; c < 3; c++) {
+        int count = counts[c];
+        GameState *games = calloc(count, sizeof(GameState));
+        Autopilot *pilots = malloc(count * sizeof(Autopilot));
+        for (int i = 0; i < count; i++) {
+            SeedGame(&games[i], i + 1);
+            InitGame(&games[i]);
+            ResetAutopilot(&pilots[i]);
+        }
+
+        double start = BenchSeconds();
+        for (long t = 0; t < ticks; t++) {
+            for (int i = 0; i < count; i++) StepGame(&games[i], AutopilotInput(&pilots[i], &games[i]));
+        }
+        double elapsed = BenchSeconds() - start;
+
+        // Spot check a few games against a solo run of the same seed
+        int mismatches = 0;
+        for (int i = 0; i < count; i += count / 4 + 1) {
+            GameState solo = {0};
+            SeedGame(&solo, i + 1);
+            InitGame(&solo);
+            ResetAutopilot(&pilots[0]); // Done with the batch, reuse its first autopilot
+            for (long t = 0; t < ticks; t++) StepGame(&solo, AutopilotInput(&pilots[0], &solo));
+            if (solo.player.x != games[i].player.x || solo.player.y != games[i].player.y ||
+                solo.enemy.x != games[i].enemy.x || solo.mazeGeneration != games[i].mazeGeneration) mismatches++;
+            CloseGame(&solo);
+        }
+
+        size_t bytes = sizeof(GameState) + sizeof(SharedGrid) + MAZE_WIDTH * MAZE_HEIGHT +
+                       games[0].grid->field.allocated * 2 * sizeof(float) +
+                       games[0].enemyHash.capacity * (5 * sizeof(int) + 2 * sizeof(CellRun));
+        printf("sessions %5d games  %10.0f ticks/s  %6zu bytes/game  mismatches %d\n",
+               count, count * ticks / elapsed, bytes, mismatches);
+
+        for (int i = 0; i < count; i++) CloseGame(&games[i]);
+        free(games);
+        free(pilots);
+    }
+}
+
+// Cores the OS reports (guess 4 where it cannot say)
+static int CpuCount() {
+#ifdef _SC_NPROCESSORS_ONLN
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpus > 0) return (int)cpus;
+#endif
+    return 4;
+}
+
+// Batched environment steps per second with 1, 2, 4, ... threads up to the core count, and a
+// check that the thread count does not change the results
+static void BenchEnvs() {
+    const int count = 4096, steps = 500, actionSets = 16;
+    unsigned char *actions = malloc((size_t)actionSets * count);
+    float *obs = malloc((size_t)count * ENV_OBS_SIZE * sizeof(float));
+    float *rewards = malloc(count * sizeof(float));
+    unsigned char *dones = malloc(count);
+    int cpus = CpuCount();
+
+    // Random arrow keys, held for a while like a real agent would
+    srand(6);
+    for (int i = 0; i < actionSets * count; i++) actions[i] = rand() & 15;
+
+    double firstChecksum = 0;
+    for (int threads = 1;; threads *= 2) {
+        if (threads > cpus) threads = cpus;
+        VecEnv *env = CreateVecEnv(count, threads, 1, ACTION_HARD, 3600);
+        ResetVecEnv(env, obs);
+
+        long episodes = 0;
+        double checksum = 0;
+        double start = BenchSeconds();
+        for (int s = 0; s < steps; s++) {
+            StepVecEnv(env, actions + (size_t)(s / 8 % actionSets) * count, obs, rewards, dones);
+            for (int i = 0; i < count; i++) {
+                episodes += dones[i] != 0;
+                checksum += rewards[i];
+            }
+        }
+        double elapsed = BenchSeconds() - start;
+        for (int i = 0; i < count * ENV_OBS_SIZE; i++) checksum += obs[i];
+        if (threads == 1) firstChecksum = checksum;
+
+        printf("envs %d x %d threads  %10.0f steps/s  %ld episodes  %s\n", count, VecEnvThreads(env),
+               (double)count * steps / elapsed, episodes, checksum == firstChecksum ? "same results" : "RESULTS DIFFER");
+        DestroyVecEnv(env);
+        if (threads == cpus) break;
+    }
+
+    free(actions);
+    free(obs);
+    free(rewards);
+    free(dones);
+}
+
+// Egocentric view writes per second for 1024 games, per window size, format and instruction
+// set, each checked byte for byte against the scalar path
+static void BenchViews() {
+    const int count = 1024, reps = 200;
+    const int views[] = {11, 33};
+    GameState *games = calloc(count, sizeof(GameState));
+    Autopilot *pilot = malloc(sizeof(Autopilot));
+    for (int i = 0; i < count; i++) {
+        SeedGame(&games[i], i + 1);
+        InitGame(&games[i]);
+        ResetAutopilot(pilot);
+        for (int t = 0; t < 100 + i % 200; t++) StepGame(&games[i], AutopilotInput(pilot, &games[i])); // Spread them around the maze
+    }
+    free(pilot);
+    SimdLevel best = GetSimdLevel();
+
+    for (int v = 0; v < 2; v++) {
+        for (int format = OBS_BITS; format <= OBS_BYTES; format++) {
+            size_t size = ObservationBufferSize(count, views[v], format);
+            ObsHeader *reference = InitObservationBuffer(malloc(size), count, views[v], format);
+            ObsHeader *buffer = InitObservationBuffer(malloc(size), count, views[v], format);
+            SetSimdLevel(SIMD_SCALAR);
+            WriteObservations(reference, games, 0, count);
+
+            for (int level = SIMD_SCALAR; level <= (int)best; level++) {
+                SetSimdLevel((SimdLevel)level);
+                double start = BenchSeconds();
+                for (int r = 0; r < reps; r++) WriteObservations(buffer, games, 0, count);
+                double elapsed = BenchSeconds() - start;
+                bool same = memcmp(ObservationData(buffer, 0), ObservationData(reference, 0), (size_t)count * buffer->envBytes) == 0;
+                printf("views %2dx%-2d %-5s %-6s  %7.1f ns/view  %4u bytes/view  %s\n", views[v], views[v],
+                       format == OBS_BITS ? "bits" : "bytes", GetSimdLevelName((SimdLevel)level),
+                       elapsed / ((double)reps * count) * 1e9, buffer->envBytes, same ? "matches scalar" : "MISMATCH");
+            }
+            free(reference);
+            free(buffer);
+        }
+    }
+
+    SetSimdLevel(best);
+    for (int i = 0; i < count; i++) CloseGame(&games[i]);
+    free(games);
+}
+
+// Snapshot plus restore cost per game. The game shares its maze with snapshots; the game is
+// fixed at 19x19, so at 1024x1024 the shared grid alone is compared with copying it.
+static void BenchSnapshot() {
+    const int reps = 1000000, copies = 200, ticks = 3000;
+    GameState game = {0};
+    GameSnapshot snapshot;
+    Autopilot *pilot = malloc(sizeof(Autopilot)), *savedPilot = malloc(sizeof(Autopilot));
+    SeedGame(&game, 3);
+    InitGame(&game);
+    ResetAutopilot(pilot);
+    for (int t = 0; t < 300; t++) StepGame(&game, AutopilotInput(pilot, &game));
+
+    double start = BenchSeconds();
+    for (int r = 0; r < reps; r++) {
+        SnapshotGame(&game, &snapshot);
+        RestoreGame(&game, &snapshot);
+        FreeSnapshot(&snapshot);
+    }
+    double elapsed = BenchSeconds() - start;
+    printf("snapshot 19x19 game          %8.1f ns snapshot + restore  %zu bytes/snapshot\n",
+           elapsed / reps * 1e9, sizeof(GameSnapshot));
+
+    // Roll back over a few new mazes, then run forward again: it must end up in the same place
+    bool maze[MAZE_HEIGHT][MAZE_WIDTH];
+    memcpy(maze, game.maze, sizeof(maze));
+    SnapshotGame(&game, &snapshot);
+    *savedPilot = *pilot;
+    int firstMaze = game.mazeGeneration;
+    for (int t = 0; t < ticks; t++) StepGame(&game, AutopilotInput(pilot, &game));
+    Vector2 ahead = game.player;
+    int mazes = game.mazeGeneration - firstMaze;
+    RestoreGame(&game, &snapshot);
+    *pilot = *savedPilot;
+    bool sameMaze = memcmp(maze, game.maze, sizeof(maze)) == 0;
+    for (int t = 0; t < ticks; t++) StepGame(&game, AutopilotInput(pilot, &game));
+    printf("snapshot rollback over %d new mazes: maze %s, replay %s\n", mazes, sameMaze ? "kept" : "CHANGED",
+           game.player.x == ahead.x && game.player.y == ahead.y ? "matches" : "DIFFERS");
+    FreeSnapshot(&snapshot);
+    CloseGame(&game);
+    free(pilot);
+    free(savedPilot);
+
+    const int sizes[] = {19, 1024};
+    for (int i = 0; i < 2; i++) {
+        int size = sizes[i];
+        SharedGrid *grid = CreateSharedGrid(NULL, size, size);
+        srand(7);
+        RandomMaze(grid->cells, size, size);
+
+        // Shared: a reference each way
+        start = BenchSeconds();
+        for (int r = 0; r < reps; r++) {
+            SharedGrid *saved = RetainGrid(grid);
+            ReleaseGrid(saved);
+        }
+        double shared = (BenchSeconds() - start) / reps;
+
+        // Copied: the whole grid out to the snapshot and back
+        SharedGrid *saved = CreateSharedGrid(grid->cells, size, size);
+        start = BenchSeconds();
+        for (int r = 0; r < copies; r++) {
+            memcpy(saved->cells, grid->cells, (size_t)size * size);
+            memcpy(grid->cells, saved->cells, (size_t)size * size);
+        }
+        double copied = (BenchSeconds() - start) / copies;
+
+        printf("snapshot %4dx%-4d grid      %8.1f ns shared  %10.1f ns copied\n", size, size, shared * 1e9, copied * 1e9);
+        ReleaseGrid(saved);
+        ReleaseGrid(grid);
+    }
+}
+
+// Float against fixed point: the chase step (sqrt and normalise) alone, then whole games
+static void BenchFixed() {
+    const int count = 4096;
+    const int reps = 20000;
+    float *ex = malloc(count * sizeof(float));
+    float *ey = malloc(count * sizeof(float));
+    float *tx = malloc(count * sizeof(float));
+    float *ty = malloc(count * sizeof(float));
+    FixedVec *fe = malloc(count * sizeof(FixedVec));
+    FixedVec *ft = malloc(count * sizeof(FixedVec));
+    SimdLevel best = GetSimdLevel();
+
+    srand(1);
+    for (int i = 0; i < count; i++) {
+        ex[i] = RandomRange(0, 760);
+        ey[i] = RandomRange(0, 760);
+        tx[i] = RandomRange(0, 760);
+        ty[i] = RandomRange(0, 760);
+    }
+    // Scalar and the best the CPU has
+    SimdLevel levels[2] = {SIMD_SCALAR, best};
+    for (int l = 0; l < (best == SIMD_SCALAR ? 1 : 2); l++) {
+        SimdLevel level = levels[l];
+        SetSimdLevel(level);
+        double start = BenchSeconds();
+        for (int r = 0; r < reps; r++) ChaseBatch(ex, ey, tx, ty, count, 2.0f);
+        double elapsed = BenchSeconds() - start;
+        printf("fixed chase float %-6s %8.3f enemies/ns\n", GetSimdLevelName(level), (double)count * reps / (elapsed * 1e9));
+    }
+    SetSimdLevel(best);
+
+    for (int i = 0; i < count; i++) {
+        fe[i] = (FixedVec){(Fixed)(ex[i] * FIXED_ONE), (Fixed)(ey[i] * FIXED_ONE)};
+        ft[i] = (FixedVec){(Fixed)(tx[i] * FIXED_ONE), (Fixed)(ty[i] * FIXED_ONE)};
+    }
+    double start = BenchSeconds();
+    for (int r = 0; r < reps; r++) {
+        for (int i = 0; i < count; i++) {
+            FixedVec move = FixedToward(fe[i], ft[i], INT_TO_FIXED(2));
+            fe[i].x += move.x;
+            fe[i].y += move.y;
+        }
+    }
+    double elapsed = BenchSeconds() - start;
+
+    // One step from fresh positions, compared against the scalar float loop
+    float maxError = 0;
+    for (int i = 0; i < count; i++) {
+        fe[i] = (FixedVec){(Fixed)(RandomRange(0, 760) * FIXED_ONE), (Fixed)(RandomRange(0, 760) * FIXED_ONE)};
+        ex[i] = FixedToFloat(fe[i].x);
+        ey[i] = FixedToFloat(fe[i].y);
+        FixedVec move = FixedToward(fe[i], ft[i], INT_TO_FIXED(2));
+        fe[i].x += move.x;
+        fe[i].y += move.y;
+    }
+    SetSimdLevel(SIMD_SCALAR);
+    ChaseBatch(ex, ey, tx, ty, count, 2.0f);
+    SetSimdLevel(best);
+    for (int i = 0; i < count; i++) {
+        maxError = fmaxf(maxError, fmaxf(fabsf(ex[i] - FixedToFloat(fe[i].x)), fabsf(ey[i] - FixedToFloat(fe[i].y))));
+    }
+    printf("fixed chase 16.16        %8.3f enemies/ns  max error %g px\n", (double)count * reps / (elapsed * 1e9), maxError);
+
+    // Autopilot games, float and fixed point, at the normal and the fastest swept speed
+    const long ticks = 50000;
+    Autopilot *pilot = malloc(sizeof(Autopilot));
+    for (int speed = 1; speed <= 5; speed += 4) {
+        for (int fixed = 0; fixed < (FIXED_POINT_FITS ? 2 : 1); fixed++) {
+            GameState game = {0};
+            SeedGame(&game, 1);
+            game.speedScale = speed;
+            game.fixedPoint = fixed;
+            InitGame(&game);
+            ResetAutopilot(pilot);
+            start = BenchSeconds();
+            for (long t = 0; t < ticks; t++) StepGame(&game, AutopilotInput(pilot, &game));
+            elapsed = BenchSeconds() - start;
+            printf("fixed game x%d %-5s        %10.0f ticks/s  %4d mazes\n", speed, fixed ? "16.16" : "float",
+                   ticks / elapsed, game.mazeGeneration);
+            CloseGame(&game);
+        }
+    }
+    free(pilot);
+
+    free(ex);
+    free(ey);
+    free(tx);
+    free(ty);
+    free(fe);
+    free(ft);
+}
+
+// Greedy wall meshing against one quad per wall cell, 19x19 up to 2048x2048: rectangles,
+// the time to mesh a maze, and the time DrawWallMesh's quad writer (WallRectQuads) takes over a
+// frame either way. The draw calls are worked out from the quads and the batch sizes (raylib's
+// default 8192 quads, the wall batch's WALL_BATCH_QUADS), not counted from rlgl.
+static void BenchMesh() {
+    const int sizes[] = {19, 64, 256, 1024, 2048};
+    const float cellSize = CELL_SIZE;
+    WallMesh mesh = {0};
+
+    for (int s = 0; s < 5; s++) {
+        int size = sizes[s];
+        bool *cells = malloc((size_t)size * size);
+        srand(1);
+        RandomMaze(cells, size, size);
+        if (size == MAZE_WIDTH) {
+            // The game's own maze rather than a random one
+            GameState game = {0};
+            SeedGame(&game, 1);
+            InitGame(&game);
+            memcpy(cells, &game.maze[0][0], (size_t)size * size);
+            CloseGame(&game);
+        }
+
+        // One rectangle per wall cell, as DrawRectangle per cell did
+        int walls = 0;
+        WallRect *perCell = malloc((size_t)size * size * sizeof(WallRect));
+        for (int i = 0; i < size * size; i++) {
+            if (!cells[i]) perCell[walls++] = (WallRect){i % size, i / size, 1, 1};
+        }
+
+        int reps = size <= 256 ? 200 : 5;
+        double start = BenchSeconds();
+        for (int r = 0; r < reps; r++) BuildWallMesh(&mesh, cells, size, size);
+        double build = (BenchSeconds() - start) / reps;
+
+        // Every wall cell in exactly one rectangle, no path cell in any
+        unsigned char *hits = calloc((size_t)size * size, 1);
+        bool exact = true;
+        for (int i = 0; i < mesh.count; i++) {
+            WallRect rect = mesh.rects[i];
+            for (int y = rect.y; y < rect.y + rect.height; y++) {
+                for (int x = rect.x; x < rect.x + rect.width; x++) hits[y * size + x]++;
+            }
+        }
+        for (int i = 0; i < size * size; i++) exact &= hits[i] == !cells[i];
+
+        // The whole maze in view, as at the default size
+        CellRange all = {0, 0, size - 1, size - 1};
+        QuadVertex *quads = malloc((size_t)walls * 4 * sizeof(QuadVertex));
+        int cellQuads = 0, meshQuads = 0;
+        start = BenchSeconds();
+        for (int r = 0; r < reps; r++) cellQuads = WallRectQuads(quads, perCell, walls, all, cellSize);
+        double cellFill = (BenchSeconds() - start) / reps;
+        start = BenchSeconds();
+        for (int r = 0; r < reps; r++) meshQuads = WallRectQuads(quads, mesh.rects, mesh.count, all, cellSize);
+        double meshFill = (BenchSeconds() - start) / reps;
+        exact &= cellQuads == walls && meshQuads == mesh.count;
+
+        printf("mesh %4dx%-4d %8d walls -> %7d rects (%5.1fx)  mesh %8.3f ms  frame fill %8.3f -> %7.3f ms  "
+               "draw calls (quads / batch) %4d -> %d  %s\n",
+               size, size, walls, mesh.count, (double)walls / mesh.count, build * 1e3, cellFill * 1e3, meshFill * 1e3,
+               (cellQuads + 8191) / 8192, (meshQuads + WALL_BATCH_QUADS - 1) / WALL_BATCH_QUADS, exact ? "exact" : "WRONG");
+
+        free(cells);
+        free(perCell);
+        free(hits);
+        free(quads);
+    }
+    FreeWallMesh(&mesh);
+}
+
+// A grid of width x height cells, all walls. The biggest only fit as untouched virtual memory,
+// which POSIX can reserve without backing; Windows gets the sizes malloc can manage.
+static bool *AllocGrid(long width, long height) {
+    size_t bytes = (size_t)width * height;
+#ifndef _WIN32
+    if (bytes > ((size_t)1 << 30)) {
+        void *cells = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        return cells == MAP_FAILED ? NULL : cells;
+    }
+#else
+    if (bytes > ((size_t)1 << 30)) return NULL;
+#endif
+    return calloc(bytes, 1);
+}
+
+static void FreeGrid(bool *cells, long width, long height) {
+#ifndef _WIN32
+    if ((size_t)width * height > ((size_t)1 << 30)) {
+        munmap(cells, (size_t)width * height);
+        return;
+    }
+#endif
+    (void)width;
+    (void)height;
+    free(cells);
+}
+
+// The camera for frame i of a scroll across the whole maze, wobbling up and down a little
+static Camera2D ScrollCamera(int frame, int frames, int size, float viewSize) {
+    float world = (float)size * CELL_SIZE;
+    Vector2 target = {world * frame / frames, world / 2 + viewSize * sinf(frame * 0.01f)};
+    return FollowCamera(target, viewSize, viewSize, world, world);
+}
+
+// Camera scrolling over mazes from 19x19 to 100000x100000 with a 760x760 view: the CPU cost of a
+// WALLS_CELLS frame (VisibleCells, then the renderer's WallCellQuads over those cells) against
+// every cell. The 100000x100000 grid only has maze along the camera's path; the rest is never read.
+static void BenchCull() {
+    const int sizes[] = {19, 1000, 100000};
+    const float viewSize = 760;
+    const int frames = 4096;
+    int maxVisible = (int)(viewSize / CELL_SIZE + 2) * (int)(viewSize / CELL_SIZE + 2);
+    QuadVertex *quads = malloc((size_t)maxVisible * 4 * sizeof(QuadVertex));
+
+    for (int s = 0; s < 3; s++) {
+        int size = sizes[s];
+        bool *cells = AllocGrid(size, size);
+        if (cells == NULL) {
+            printf("cull %6dx%-6d cannot reserve the grid, skipped\n", size, size);
+            continue;
+        }
+        // The biggest maze only gets cells where the camera passes, so the rest never takes memory
+        srand(1);
+        if (size <= 1000) RandomMaze(cells, size, size);
+        for (int i = 0; i < frames && size > 1000; i++) {
+            CellRange visible =
+                VisibleCells(CameraView(ScrollCamera(i, frames, size, viewSize), viewSize, viewSize), CELL_SIZE, size, size);
+            for (int y = visible.minY; y <= visible.maxY; y++) {
+                for (int x = visible.minX; x <= visible.maxX; x++) {
+                    // As RandomMaze
+                    bool border = x == 0 || y == 0 || x == size - 1 || y == size - 1;
+                    bool room = (x & 1) && (y & 1);
+                    bool link = ((x & 1) != (y & 1)) && rand() % 2 == 0;
+                    cells[(size_t)y * size + x] = !border && (room || link);
+                }
+            }
+        }
+
+        long drawn = 0;
+        double start = BenchSeconds();
+        for (int i = 0; i < frames; i++) {
+            Camera2D camera = ScrollCamera(i, frames, size, viewSize);
+            CellRange visible = VisibleCells(CameraView(camera, viewSize, viewSize), CELL_SIZE, size, size);
+            drawn += WallCellQuads(quads, cells, size, visible, 0, 0, CELL_SIZE);
+        }
+        double culled = (BenchSeconds() - start) / frames;
+
+        // Every cell every frame, as before the camera
+        if (size <= 1000) {
+            CellRange all = {0, 0, size - 1, size - 1};
+            QuadVertex *allQuads = malloc((size_t)size * size * 4 * sizeof(QuadVertex));
+            int reps = size <= 64 ? frames : 20;
+            start = BenchSeconds();
+            for (int i = 0; i < reps; i++) WallCellQuads(allQuads, cells, size, all, 0, 0, CELL_SIZE);
+            double full = (BenchSeconds() - start) / reps;
+            printf("cull %6dx%-6d %5.0f quads/frame  culled %8.2f us/frame  every cell %10.2f us/frame\n", size, size,
+                   (double)drawn / frames, culled * 1e6, full * 1e6);
+            free(allQuads);
+        } else {
+            printf("cull %6dx%-6d %5.0f quads/frame  culled %8.2f us/frame  every cell %10s (%ld cells)\n", size, size,
+                   (double)drawn / frames, culled * 1e6, "-", (long)size * size);
+        }
+        FreeGrid(cells, size, size);
+    }
+    free(quads);
+}
+
+// Where the camera looks in frame i of a chunk benchmark run
+typedef Vector2 (*CameraPath)(int frame, float world);
+
+// Walking right at player speed along the middle row
+static Vector2 WalkPath(int frame, float world) {
+    return (Vector2){400 + frame * 4.0f, world / 2};
+}
+
+// Pacing back and forth over a few screens
+static Vector2 PacePath(int frame, float world) {
+    return (Vector2){world / 2 + 2000 * sinf(frame * 0.005f), world / 2 + 600 * sinf(frame * 0.013f)};
+}
+
+// A new place every second, as a new maze or a teleport does
+static Vector2 JumpPath(int frame, float world) {
+    return (Vector2){world / 2 + (frame / 60 % 7) * 3000.0f, world / 2 + (frame / 60 % 5) * 3000.0f};
+}
+
+// The chunk cache over a 100000x100000 maze with a 760x760 view, for three ways of moving: hit
+// rate, chunks built per frame, the CPU cost of building one (BuildChunk's WallCellQuads, without
+// the rlgl copy and texture switch the game's LogChunkStats also counts), and the texture memory
+// the cache is held to
+static void BenchChunks() {
+    const int size = 100000;
+    const float view = 760, world = (float)size * CELL_SIZE;
+    const int frames = 20000;
+    const struct {
+        const char *name;
+        CameraPath path;
+    } paths[] = {{"walk", WalkPath}, {"pace", PacePath}, {"jump", JumpPath}};
+
+    bool *cells = AllocGrid(size, size);
+    if (cells == NULL) {
+        printf("chunks cannot reserve the grid, skipped\n");
+        return;
+    }
+    QuadVertex *quads = malloc(CHUNK_CELLS * CHUNK_CELLS * 4 * sizeof(QuadVertex));
+    unsigned char *filled = calloc(((size_t)size / CHUNK_CELLS + 1) * (size / CHUNK_CELLS + 1) / 8 + 1, 1);
+    srand(1);
+
+    for (int p = 0; p < 3; p++) {
+        ChunkCache cache = {0};
+        double start = BenchSeconds();
+        for (int i = 0; i < frames; i++) {
+            Camera2D camera = FollowCamera(paths[p].path(i, world), view, view, world, world);
+            CellRange chunks = ChunksOf(VisibleCells(CameraView(camera, view, view), CELL_SIZE, size, size));
+            for (int y = chunks.minY; y <= chunks.maxY; y++) {
+                for (int x = chunks.minX; x <= chunks.maxX; x++) {
+                    bool build;
+                    LookupChunk(&cache, x, y, &build);
+                    if (!build) continue;
+                    CellRange range = ChunkCells(x, y, size, size);
+                    // Chunks get their maze the first time they are built, so the rest never takes memory
+                    size_t chunk = (size_t)y * (size / CHUNK_CELLS + 1) + x;
+                    if (!(filled[chunk / 8] & (1 << chunk % 8))) {
+                        filled[chunk / 8] |= 1 << chunk % 8;
+                        for (int cy = range.minY; cy <= range.maxY; cy++) {
+                            for (int cx = range.minX; cx <= range.maxX; cx++) {
+                                bool room = (cx & 1) && (cy & 1);
+                                bool link = ((cx & 1) != (cy & 1)) && rand() % 2 == 0;
+                                cells[(size_t)cy * size + cx] = cx > 0 && cy > 0 && (room || link);
+                            }
+                        }
+                    }
+
+                    double buildStart = BenchSeconds();
+                    WallCellQuads(quads, cells, size, range, range.minX, range.minY, CELL_SIZE);
+                    cache.buildSeconds += BenchSeconds() - buildStart;
+                }
+            }
+        }
+        double total = BenchSeconds() - start;
+        long lookups = cache.hits + cache.misses;
+        printf("chunks %-5s %6.2f%% hits  %6.3f builds/frame  %7.2f us/build  %6ld evictions  %6.2f us/frame  "
+               "cache %d chunks = %.1f MB\n",
+               paths[p].name, 100.0 * cache.hits / lookups, (double)cache.misses / frames,
+               cache.buildSeconds * 1e6 / (cache.misses ? cache.misses : 1), cache.evictions, total * 1e6 / frames,
+               CHUNK_CACHE_SLOTS, CHUNK_CACHE_SLOTS * (double)(CHUNK_CELLS * CELL_SIZE) * (CHUNK_CELLS * CELL_SIZE) * 4 / (1 << 20));
+    }
+    free(filled);
+    free(quads);
+    FreeGrid(cells, size, size);
+}
+
+// A model of DrawCircleV's vertices for each circle (raylib's DrawCircleSector, which needs a
+// window): 36 segments as 18 quads, every corner from sines and cosines
+static int FillCircles(QuadVertex *out, const float *x, const float *y, const Color *colors, int count, float radius) {
+    const float step = 360.0f / 36;
+    QuadVertex *start = out;
+    for (int i = 0; i < count; i++) {
+        float angle = 0;
+        for (int q = 0; q < 18; q++) {
+            out[0] = (QuadVertex){x[i], y[i], 0, 0, colors[i]};
+            out[1] = (QuadVertex){x[i] + cosf(DEG2RAD * (angle + step * 2)) * radius,
+                                  y[i] + sinf(DEG2RAD * (angle + step * 2)) * radius, 0, 0, colors[i]};
+            out[2] = (QuadVertex){x[i] + cosf(DEG2RAD * (angle + step)) * radius,
+                                  y[i] + sinf(DEG2RAD * (angle + step)) * radius, 0, 0, colors[i]};
+            out[3] = (QuadVertex){x[i] + cosf(DEG2RAD * angle) * radius, y[i] + sinf(DEG2RAD * angle) * radius, 0, 0,
+                                  colors[i]};
+            out += 4;
+            angle += step * 2;
+        }
+    }
+    return (int)(out - start) / 4;
+}
+
+// Entities as tessellated circles (the DrawCircleV model above) against DrawSprites' own quad
+// writer (SpriteQuads, culling test and colours included) at 1k, 10k and 50k, all in a 760x760 view:
+// the CPU cost of a frame's vertices. The draw calls are worked out from the quads and the batch sizes
+// (raylib's default 8192 quads, the sprite batch grown as DrawSprites grows it), not counted from rlgl.
+static void BenchSprites() {
+    const int counts[] = {1000, 10000, 50000};
+    const float radius = CELL_SIZE / 2;
+    const Rectangle view = {0, 0, 760, 760};
+
+    for (int k = 0; k < 3; k++) {
+        int count = counts[k];
+        float *x = malloc(count * sizeof(float));
+        float *y = malloc(count * sizeof(float));
+        Color *colors = malloc(count * sizeof(Color));
+        QuadVertex *quads = malloc((size_t)count * 18 * 4 * sizeof(QuadVertex));
+        srand(4);
+        for (int i = 0; i < count; i++) {
+            x[i] = RandomRange(0, 760);
+            y[i] = RandomRange(0, 760);
+            colors[i] = i % 2 ? RED : BLUE;
+        }
+
+        int reps = count <= 10000 ? 50 : 10;
+        int circleQuads = 0, spriteQuads = 0;
+        double start = BenchSeconds();
+        for (int r = 0; r < reps; r++) circleQuads = FillCircles(quads, x, y, colors, count, radius);
+        double circles = (BenchSeconds() - start) / reps;
+        start = BenchSeconds();
+        for (int r = 0; r < reps; r++) spriteQuads = SpriteQuads(quads, x, y, colors, count, radius, view);
+        double sprites = (BenchSeconds() - start) / reps;
+
+        // DrawSprites' batch starts at 1024 quads and grows with the count
+        int desktop = GrowBatchCapacity(1024, count, SPRITE_BATCH_MAX);
+        int es = GrowBatchCapacity(1024, count, WALL_BATCH_QUADS);
+        printf("sprites %6d entities  circles %8.3f ms %8d quads %4d draws  sprites %7.3f ms %6d quads "
+               "%d draw (%d on ES)  %5.1fx  (draws = quads / batch)\n",
+               count, circles * 1e3, circleQuads, (circleQuads + 8191) / 8192, sprites * 1e3, spriteQuads,
+               (spriteQuads + desktop - 1) / desktop, (spriteQuads + es - 1) / es, circles / sprites);
+        free(x);
+        free(y);
+        free(colors);
+        free(quads);
+    }
+}
+
+// Walk the first frames of the minimap benchmark on a fresh minimap, pasting every packed upload
+// into a copy of the texture the way UpdateTextureRec does. True if each upload fills exactly its
+// rectangle and the copy matches the minimap after every frame.
+static bool CheckMinimapUploads(const bool *cells, int size, int row, int frames) {
+    Minimap map;
+    InitMinimap(&map, size, size);
+    size_t pixels = (size_t)map.pixelsWide * map.pixelsHigh;
+    Color *texture = calloc(pixels, sizeof(Color));
+    Color *staging = malloc((pixels + 1) * sizeof(Color));
+    const Color unwritten = {1, 2, 3, 4}; // No minimap pixel has that alpha
+    bool exact = true;
+
+    for (int i = -1; i < frames && exact; i++) {
+        if (i >= 0) RevealAround(&map, cells, (int)(WalkPath(i, 0).x / CELL_SIZE) % size, row);
+        for (size_t p = 0; p <= pixels; p++) staging[p] = unwritten;
+        CellRange dirty = CopyDirtyPixels(&map, staging); // Frame -1 is the clear
+        size_t area = 0;
+        if (dirty.maxX >= dirty.minX) {
+            int columns = dirty.maxX - dirty.minX + 1;
+            area = (size_t)columns * (dirty.maxY - dirty.minY + 1);
+            for (int y = dirty.minY; y <= dirty.maxY; y++) {
+                memcpy(texture + (size_t)y * map.pixelsWide + dirty.minX,
+                       staging + (size_t)(y - dirty.minY) * columns, columns * sizeof(Color));
+            }
+        }
+        for (size_t p = 0; p < area; p++) exact &= staging[p].a != unwritten.a;
+        exact &= staging[area].a == unwritten.a;
+        exact &= memcmp(texture, map.pixels, pixels * sizeof(Color)) == 0;
+    }
+    FreeMinimap(&map);
+    free(texture);
+    free(staging);
+    return exact;
+}
+
+// A player walking across 1000x1000 and 100000x100000 mazes with the minimap discovering the
+// cells around it (RevealAround and CopyDirtyPixels, as UpdateMinimapRenderer runs them): the cost
+// per frame of discovering and packing the changed pixels for upload, against building the whole
+// minimap again each frame where that is possible, and a check of the uploads
+static void BenchMinimap() {
+    const int sizes[] = {1000, 100000};
+    const int frames = 20000;
+
+    for (int s = 0; s < 2; s++) {
+        int size = sizes[s];
+        bool *cells = AllocGrid(size, size);
+        if (cells == NULL) {
+            printf("minimap %6dx%-6d cannot reserve the grid, skipped\n", size, size);
+            continue;
+        }
+        Minimap map;
+        InitMinimap(&map, size, size);
+        Color *staging = malloc((size_t)map.pixelsWide * map.pixelsHigh * sizeof(Color));
+        CopyDirtyPixels(&map, staging); // The clear, uploaded once per maze
+
+        // The walk only touches the rows around the middle, so only those get a maze
+        srand(1);
+        int row = size / 2;
+        for (int y = row - MINIMAP_REVEAL; y <= row + MINIMAP_REVEAL; y++) {
+            for (int x = 0; x < size; x++) {
+                bool room = (x & 1) && (y & 1);
+                bool link = ((x & 1) != (y & 1)) && rand() % 2 == 0;
+                cells[(size_t)y * size + x] = x > 0 && x < size - 1 && (room || link);
+            }
+        }
+
+        long uploaded = 0;
+        double start = BenchSeconds();
+        for (int i = 0; i < frames; i++) {
+            RevealAround(&map, cells, (int)(WalkPath(i, 0).x / CELL_SIZE) % size, row);
+            CellRange dirty = CopyDirtyPixels(&map, staging);
+            if (dirty.maxX >= dirty.minX) uploaded += (long)(dirty.maxX - dirty.minX + 1) * (dirty.maxY - dirty.minY + 1);
+        }
+        double incremental = (BenchSeconds() - start) / frames;
+        const char *uploads = CheckMinimapUploads(cells, size, row, 2000) ? "exact" : "WRONG";
+
+        if (size <= 1000) {
+            int reps = 20;
+            CellRange all = {0, 0, size - 1, size - 1};
+            start = BenchSeconds();
+            for (int r = 0; r < reps; r++) {
+                ClearMinimap(&map);
+                RevealCells(&map, cells, all);
+                CopyDirtyPixels(&map, staging);
+            }
+            double full = (BenchSeconds() - start) / reps;
+            printf("minimap %6dx%-6d %3dx%-3d pixels  incremental %6.3f us/frame %6.2f pixels/frame  rebuild %9.1f us/frame  "
+                   "uploads %s\n",
+                   size, size, map.pixelsWide, map.pixelsHigh, incremental * 1e6, (double)uploaded / frames, full * 1e6,
+                   uploads);
+        } else {
+            printf("minimap %6dx%-6d %3dx%-3d pixels  incremental %6.3f us/frame %6.2f pixels/frame  rebuild %9s  "
+                   "uploads %s\n",
+                   size, size, map.pixelsWide, map.pixelsHigh, incremental * 1e6, (double)uploaded / frames, "-", uploads);
+        }
+        FreeMinimap(&map);
+        free(staging);
+        FreeGrid(cells, size, size);
+    }
+}
+
+// Shadowcasting field of view in a 1024x1024 maze and an open 1024x1024 room, per view radius:
+// the cost of one recompute from a random path cell, and the cells in sight. A walking player
+// only recomputes on entering a new cell, once every CELL_SIZE / PLAYER_SPEED frames.
+static void BenchFov() {
+    const int size = 1024;
+    const int radii[] = {4, 8, 16, 32, 64};
+    bool *maze = malloc((size_t)size * size);
+    bool *room = malloc((size_t)size * size);
+    srand(6);
+    RandomMaze(maze, size, size);
+    for (int i = 0; i < size * size; i++) {
+        int x = i % size, y = i / size;
+        room[i] = x > 0 && y > 0 && x < size - 1 && y < size - 1;
+    }
+
+    for (int r = 0; r < 5; r++) {
+        int radius = radii[r];
+        const bool *grids[2] = {maze, room};
+        double cost[2];
+        double seen[2];
+        for (int g = 0; g < 2; g++) {
+            FieldOfView fov;
+            InitFieldOfView(&fov, size, size, radius);
+            int reps = radius <= 16 ? 20000 : 2000;
+            long inSight = 0;
+            srand(7);
+            double start = BenchSeconds();
+            for (int i = 0; i < reps; i++) {
+                // Odd cells are always paths in both grids
+                int x = 1 + 2 * (rand() % (size / 2 - 1)), y = 1 + 2 * (rand() % (size / 2 - 1));
+                UpdateFieldOfView(&fov, grids[g], x, y);
+            }
+            cost[g] = (BenchSeconds() - start) / reps;
+            for (int i = 0; i < 200; i++) {
+                int x = 1 + 2 * (rand() % (size / 2 - 1)), y = 1 + 2 * (rand() % (size / 2 - 1));
+                UpdateFieldOfView(&fov, grids[g], x, y);
+                inSight += fov.litCount;
+            }
+            seen[g] = inSight / 200.0;
+            FreeFieldOfView(&fov);
+        }
+        printf("fov radius %2d  maze %8.2f us %5.0f cells in sight  open room %8.2f us %5.0f cells in sight  "
+               "walking %.3f us/frame\n",
+               radius, cost[0] * 1e6, seen[0], cost[1] * 1e6, seen[1], cost[0] * 1e6 * PLAYER_SPEED / CELL_SIZE);
+    }
+    free(maze);
+    free(room);
+}
+
+// Whole-game macro benchmark: the standard corpus of recorded sessions replayed at full speed
+static void BenchReplay() {
+    RunReplays(0, NULL);
+}
+
+typedef struct {
+    const char *name;
+    void (*run)();
+} Benchmark;
+
+static const Benchmark benchmarks[] = {
+    {"chase", BenchChase},
+    {"walls", BenchWalls},
+    {"broadphase", BenchBroadphase},
+    {"field", BenchField},
+    {"sweep", BenchSweep},
+    {"replay", BenchReplay},
+    {"sessions", BenchSessions},
+    {"envs", BenchEnvs},
+    {"views", BenchViews},
+    {"snapshot", BenchSnapshot},
+    {"fixed", BenchFixed},
+    {"mesh", BenchMesh},
+    {"cull", BenchCull},
+    {"chunks", BenchChunks},
+    {"sprites", BenchSprites},
+    {"minimap", BenchMinimap},
+    {"fov", BenchFov},
+};
+
+int RunBenchmarks(const char *name) {
+    int ran = 0;
+    for (size_t i = 0; i < sizeof(benchmarks) / sizeof(benchmarks[0]); i++) {
+        if (name == NULL || strcmp(name, benchmarks[i].name) == 0) {
+            benchmarks[i].run();
+            ran++;
+        }
+    }
+    if (ran == 0) {
+        printf("Unknown benchmark: %s\n", name);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,10 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+// Wall clock time in seconds, for benchmarks and tick rate reports
+double BenchSeconds();
+
+// Run the benchmark called name (or all of them if name is NULL), returns the exit code
+int RunBenchmarks(const char *name);
+
+#endif
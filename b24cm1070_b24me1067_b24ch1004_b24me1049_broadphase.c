@@ -0,0 +1,175 @@
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_broadphase.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Cell keys are sorted 11 bits per pass, so up to three passes cover any int cell
+#define RADIX_BITS 11
+#define RADIX_SIZE (1 << RADIX_BITS)
+
+void InitSpatialHash(SpatialHash *hash, int width, int height, float cellSize) {
+    memset(hash, 0, sizeof(*hash));
+    hash->cellSize = cellSize;
+    hash->width = width;
+    hash->height = height;
+}
+
+void FreeSpatialHash(SpatialHash *hash) {
+    free(hash->entries);
+    free(hash->entryCell);
+    free(hash->entityCell);
+    free(hash->scratch);
+    free(hash->runs);
+    memset(hash, 0, sizeof(*hash));
+}
+
+// Grid column (or row) of a coordinate, clamped to the grid
+static int CellCoord(float v, float cellSize, int limit) {
+    int c = (int)floorf(v / cellSize);
+    if (c < 0) return 0;
+    if (c >= limit) return limit - 1;
+    return c;
+}
+
+// Slot of cell in the run table: its own slot if present, else the empty slot it would take
+static int CellSlot(const SpatialHash *hash, int cell) {
+    int slot = (int)(((unsigned int)cell * 2654435761u) >> 7) & hash->runMask;
+    while (hash->runs[slot].cell != cell && hash->runs[slot].cell != -1) slot = (slot + 1) & hash->runMask;
+    return slot;
+}
+
+void RebuildSpatialHash(SpatialHash *hash, const float *x, const float *y, int count) {
+    if (count > hash->capacity) {
+        int capacity = hash->capacity ? hash->capacity : 1;
+        while (capacity < count) capacity *= 2;
+        hash->entries = realloc(hash->entries, capacity * sizeof(int));
+        hash->entryCell = realloc(hash->entryCell, capacity * sizeof(int));
+        hash->entityCell = realloc(hash->entityCell, capacity * sizeof(int));
+        hash->scratch = realloc(hash->scratch, 2 * (size_t)capacity * sizeof(int));
+        hash->runs = realloc(hash->runs, 2 * (size_t)capacity * sizeof(CellRun));
+        hash->capacity = capacity;
+    }
+    hash->count = count;
+
+    for (int i = 0; i < count; i++) {
+        int c = CellCoord(y[i], hash->cellSize, hash->height) * hash->width +
+                CellCoord(x[i], hash->cellSize, hash->width);
+        hash->entityCell[i] = c;
+        hash->entries[i] = i;
+        hash->entryCell[i] = c;
+    }
+
+    // LSD radix sort of (cell, id) pairs; each pass is stable, so ids stay ascending within a cell.
+    // Passes stop once the remaining digits of the largest cell are zero.
+    int maxCell = hash->width * hash->height - 1;
+    int *ids = hash->entries, *cells = hash->entryCell;
+    int *sortedIds = hash->scratch, *sortedCells = hash->scratch + hash->capacity;
+    for (int shift = 0; shift < 32 && count > 1; shift += RADIX_BITS) {
+        if (shift > 0 && (maxCell >> shift) == 0) break;
+
+        int offsets[RADIX_SIZE + 1] = {0};
+        for (int i = 0; i < count; i++) offsets[((cells[i] >> shift) & (RADIX_SIZE - 1)) + 1]++;
+        for (int d = 0; d < RADIX_SIZE; d++) offsets[d + 1] += offsets[d];
+        for (int i = 0; i < count; i++) {
+            int slot = offsets[(cells[i] >> shift) & (RADIX_SIZE - 1)]++;
+            sortedIds[slot] = ids[i];
+            sortedCells[slot] = cells[i];
+        }
+
+        int *swap = ids; ids = sortedIds; sortedIds = swap;
+        swap = cells; cells = sortedCells; sortedCells = swap;
+    }
+    if (ids != hash->entries) {
+        memcpy(hash->entries, ids, count * sizeof(int));
+        memcpy(hash->entryCell, cells, count * sizeof(int));
+    }
+
+    // Index every run of equal cells in a table of at least twice as many slots as entities
+    int slots = 2;
+    while (slots < 2 * count) slots *= 2;
+    hash->runMask = slots - 1;
+    for (int slot = 0; slot <= hash->runMask; slot++) hash->runs[slot].cell = -1;
+    for (int e = 0; e < count;) {
+        int cell = hash->entryCell[e], start = e;
+        while (e < count && hash->entryCell[e] == cell) e++;
+        int slot = CellSlot(hash, cell);
+        hash->runs[slot] = (CellRun){cell, start, e};
+    }
+}
+
+// Run of entries in cell, or NULL if the cell is empty
+static const CellRun *FindRun(const SpatialHash *hash, int cell) {
+    const CellRun *run = &hash->runs[CellSlot(hash, cell)];
+    return run->cell == cell ? run : NULL;
+}
+
+int QuerySpatialHash(const SpatialHash *hash, const float *x, const float *y,
+                     float qx, float qy, float radius, int *out, int maxOut) {
+    if (hash->count == 0) return 0;
+
+    int minX = CellCoord(qx - radius, hash->cellSize, hash->width);
+    int maxX = CellCoord(qx + radius, hash->cellSize, hash->width);
+    int minY = CellCoord(qy - radius, hash->cellSize, hash->height);
+    int maxY = CellCoord(qy + radius, hash->cellSize, hash->height);
+    float radius2 = radius * radius;
+    int found = 0;
+
+    for (int cy = minY; cy <= maxY; cy++) {
+        for (int cx = minX; cx <= maxX; cx++) {
+            const CellRun *run = FindRun(hash, cy * hash->width + cx);
+            if (!run) continue;
+            for (int e = run->start; e < run->end; e++) {
+                int id = hash->entries[e];
+                float diffX = x[id] - qx;
+                float diffY = y[id] - qy;
+                if (diffX * diffX + diffY * diffY <= radius2) {
+                    if (found < maxOut) out[found] = id;
+                    found++;
+                }
+            }
+        }
+    }
+    return found;
+}
+
+void SeparateEntities(const SpatialHash *hash, float *x, float *y, float minDistance) {
+    float minDistance2 = minDistance * minDistance;
+    int reach = (int)ceilf(minDistance / hash->cellSize);
+    if (hash->count <= 1) return; // No pairs
+
+    for (int i = 0; i < hash->count; i++) {
+        int cell = hash->entityCell[i];
+        int cx = cell % hash->width;
+        int cy = cell / hash->width;
+        int minX = cx - reach < 0 ? 0 : cx - reach;
+        int maxX = cx + reach >= hash->width ? hash->width - 1 : cx + reach;
+
+        for (int row = cy - reach; row <= cy + reach; row++) {
+            if (row < 0 || row >= hash->height) continue;
+            for (int column = minX; column <= maxX; column++) {
+                const CellRun *run = FindRun(hash, row * hash->width + column);
+                if (!run) continue;
+
+                for (int e = run->start; e < run->end; e++) {
+                    int j = hash->entries[e];
+                    if (j <= i) continue; // Each pair once
+
+                    float diffX = x[j] - x[i];
+                    float diffY = y[j] - y[i];
+                    float dist2 = diffX * diffX + diffY * diffY;
+                    if (dist2 >= minDistance2) continue;
+
+                    // Move both halfway out of the overlap (along x if they sit on top of each other)
+                    float dist = sqrtf(dist2);
+                    float push = (minDistance - dist) * 0.5f;
+                    float dirX = dist > 0 ? diffX / dist : 1;
+                    float dirY = dist > 0 ? diffY / dist : 0;
+                    x[i] -= dirX * push;
+                    y[i] -= dirY * push;
+                    x[j] += dirX * push;
+                    y[j] += dirY * push;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,38 @@
+#ifndef BROADPHASE_H
+#define BROADPHASE_H
+
+// Run of sorted entries that share one cell, stored in an open addressed table keyed by cell
+typedef struct {
+    int cell;           // -1 for an empty slot
+    int start, end;     // The cell's entities are entries[start .. end)
+} CellRun;
+
+// Uniform grid over the maze for entity-entity collision. Rebuilt every tick by radix
+// sorting entity ids on their cell, so the cost follows the entity count, not the maze size.
+typedef struct {
+    float cellSize;
+    int width, height;  // In cells
+    int *entries;       // Entity ids sorted by cell
+    int *entryCell;     // Cell of entries[e], ascending
+    int *entityCell;    // Cell of every entity from the last rebuild
+    int *scratch;       // Sort buffer (ids, then cells)
+    CellRun *runs;      // Occupied cells, at most half of the slots in use are filled
+    int runMask;        // Slots in use minus one (a power of two, sized to the last rebuild)
+    int capacity;       // Entities the arrays can hold
+    int count;          // Entities in the last rebuild
+} SpatialHash;
+
+void InitSpatialHash(SpatialHash *hash, int width, int height, float cellSize);
+void FreeSpatialHash(SpatialHash *hash);
+
+// Bin count entities by position (positions outside the grid go to the border cells)
+void RebuildSpatialHash(SpatialHash *hash, const float *x, const float *y, int count);
+
+// Write up to maxOut ids of entities within radius of (qx, qy) to out, returns how many there are
+int QuerySpatialHash(const SpatialHash *hash, const float *x, const float *y,
+                     float qx, float qy, float radius, int *out, int maxOut);
+
+// Push apart every pair of entities closer than minDistance (one relaxation pass)
+void SeparateEntities(const SpatialHash *hash, float *x, float *y, float minDistance);
+
+#endif
@@ -0,0 +1,52 @@
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_chunks.h"
+
+void ClearChunkCache(ChunkCache *cache) {
+    for (int i = 0; i < CHUNK_CACHE_SLOTS; i++) cache->slots[i].used = false;
+}
+
+int FindChunk(const ChunkCache *cache, int x, int y) {
+    for (int i = 0; i < CHUNK_CACHE_SLOTS; i++) {
+        const ChunkSlot *slot = &cache->slots[i];
+        if (slot->used && slot->x == x && slot->y == y) return i;
+    }
+    return -1;
+}
+
+int LookupChunk(ChunkCache *cache, int x, int y, bool *build) {
+    cache->clock++;
+    int found = FindChunk(cache, x, y);
+    if (found >= 0) {
+        cache->hits++;
+        cache->slots[found].lastUsed = cache->clock;
+        *build = false;
+        return found;
+    }
+
+    // An empty slot if there is one, otherwise the one looked up longest ago
+    int victim = 0;
+    for (int i = 0; i < CHUNK_CACHE_SLOTS; i++) {
+        if (!cache->slots[i].used) {
+            victim = i;
+            break;
+        }
+        if (cache->slots[i].lastUsed < cache->slots[victim].lastUsed) victim = i;
+    }
+    if (cache->slots[victim].used) cache->evictions++;
+    cache->misses++;
+    cache->slots[victim] = (ChunkSlot){x, y, cache->clock, true};
+    *build = true;
+    return victim;
+}
+
+CellRange ChunksOf(CellRange cells) {
+    if (cells.maxX < cells.minX || cells.maxY < cells.minY) return cells;
+    return (CellRange){cells.minX / CHUNK_CELLS, cells.minY / CHUNK_CELLS, cells.maxX / CHUNK_CELLS,
+                       cells.maxY / CHUNK_CELLS};
+}
+
+CellRange ChunkCells(int x, int y, int width, int height) {
+    CellRange cells = {x * CHUNK_CELLS, y * CHUNK_CELLS, (x + 1) * CHUNK_CELLS - 1, (y + 1) * CHUNK_CELLS - 1};
+    if (cells.maxX >= width) cells.maxX = width - 1;
+    if (cells.maxY >= height) cells.maxY = height - 1;
+    return cells;
+}
@@ -0,0 +1,47 @@
+#ifndef CHUNKS_H
+#define CHUNKS_H
+
+#include <stdbool.h>
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_view.h"
+
+// Cells along each side of a render chunk
+#define CHUNK_CELLS 16
+
+// Chunks the cache keeps at once. A 760x760 view sees at most 3x3 chunks of 16 cells, so a
+// frame never evicts a chunk it is still using; the rest keep recently left ground around.
+#define CHUNK_CACHE_SLOTS 32
+
+// Which chunk a cache slot holds, and when it was last looked up
+typedef struct {
+    int x, y;
+    long lastUsed;
+    bool used;
+} ChunkSlot;
+
+// Least recently used cache of maze chunks, a fixed number of slots whatever the maze size.
+// It only keeps the bookkeeping; whoever owns it keeps a texture (or anything else) per slot
+// and builds it when a lookup says so.
+typedef struct {
+    ChunkSlot slots[CHUNK_CACHE_SLOTS];
+    long clock;          // Lookups so far, stamps the slots
+    long hits, misses;   // Lookups that found their chunk, and those that had to build it
+    long evictions;      // Misses that took a slot from another chunk
+    double buildSeconds; // Time spent building chunks, added by whoever builds them
+} ChunkCache;
+
+// Forget every chunk (a new maze), keeping the counters
+void ClearChunkCache(ChunkCache *cache);
+
+// The slot for chunk (x, y). Sets build when the slot does not hold it yet and must be built.
+int LookupChunk(ChunkCache *cache, int x, int y, bool *build);
+
+// The slot holding chunk (x, y), or -1, without counting a lookup
+int FindChunk(const ChunkCache *cache, int x, int y);
+
+// The chunks that cover a range of cells
+CellRange ChunksOf(CellRange cells);
+
+// The cells of chunk (x, y) in a width x height maze
+CellRange ChunkCells(int x, int y, int width, int height);
+
+#endif
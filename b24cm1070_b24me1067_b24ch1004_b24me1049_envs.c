@@ -0,0 +1,203 @@
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_envs.h"
+#include <pthread.h>
+#include <stdlib.h>
+
+// Each thread steps one contiguous slice of the environments
+typedef struct {
+    VecEnv *env;
+    int part;
+} EnvWorker;
+
+struct VecEnv {
+    int count;
+    GameState *games;
+    int *episodeTicks;
+    GameAction difficulty;
+    int maxTicks;
+
+    // The step being worked on
+    const unsigned char *actions;
+    float *observations;
+    float *rewards;
+    unsigned char *dones;
+    ObsHeader *views; // Egocentric views, if asked for
+
+    // Thread pool: workers wait for generation to change, step their slice, then count down pending
+    int parts;
+    pthread_t *threads;
+    EnvWorker *workers;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    pthread_cond_t finished;
+    int generation;
+    int pending;
+    bool quit;
+};
+
+static void WriteObservation(const GameState *game, float *obs) {
+    const float scaleX = 1.0f / (MAZE_WIDTH * CELL_SIZE);
+    const float scaleY = 1.0f / (MAZE_HEIGHT * CELL_SIZE);
+    obs[0] = game->player.x * scaleX;
+    obs[1] = game->player.y * scaleY;
+    obs[2] = (game->enemy.x - game->player.x) * scaleX;
+    obs[3] = (game->enemy.y - game->player.y) * scaleY;
+    obs[4] = (GOAL_X - game->player.x) * scaleX;
+    obs[5] = (GOAL_Y - game->player.y) * scaleY;
+}
+
+static void StepSlice(VecEnv *env, int part) {
+    int begin = (int)((long long)env->count * part / env->parts);
+    int end = (int)((long long)env->count * (part + 1) / env->parts);
+
+    for (int i = begin; i < end; i++) {
+        GameState *game = &env->games[i];
+        GameInput input = {(unsigned char)(env->actions[i] & 15), ACTION_NONE};
+        int events = StepGame(game, input);
+        float reward = ENV_REWARD_TICK;
+        unsigned char done = 0;
+        env->episodeTicks[i]++;
+
+        if (events & EVENT_MAZE_WON) {
+            // UpdateGame has already put the player back at the start of a new maze
+            reward = ENV_REWARD_WIN;
+            done = ENV_DONE_WON;
+        } else if (events & EVENT_CAUGHT) {
+            reward = ENV_REWARD_CAUGHT;
+            done = ENV_DONE_CAUGHT;
+            StartRound(game, env->difficulty);
+        } else if (env->maxTicks > 0 && env->episodeTicks[i] >= env->maxTicks) {
+            done = ENV_DONE_TIMEOUT;
+            StartRound(game, env->difficulty);
+        }
+        if (done) env->episodeTicks[i] = 0;
+
+        env->rewards[i] = reward;
+        env->dones[i] = done;
+        WriteObservation(game, env->observations + (size_t)i * ENV_OBS_SIZE);
+    }
+    if (env->views != NULL) WriteObservations(env->views, env->games, begin, end);
+}
+
+static void *EnvWorkerLoop(void *arg) {
+    EnvWorker *worker = arg;
+    VecEnv *env = worker->env;
+    int seen = 0;
+
+    pthread_mutex_lock(&env->lock);
+    while (true) {
+        while (env->generation == seen && !env->quit) pthread_cond_wait(&env->wake, &env->lock);
+        if (env->quit) break;
+        seen = env->generation;
+        pthread_mutex_unlock(&env->lock);
+
+        StepSlice(env, worker->part);
+
+        pthread_mutex_lock(&env->lock);
+        if (--env->pending == 0) pthread_cond_signal(&env->finished);
+    }
+    pthread_mutex_unlock(&env->lock);
+    return NULL;
+}
+
+VecEnv *CreateVecEnv(int count, int threads, unsigned int seed, GameAction difficulty, int maxTicks) {
+    VecEnv *env = calloc(1, sizeof(VecEnv));
+    env->count = count;
+    env->difficulty = difficulty;
+    env->maxTicks = maxTicks;
+    env->games = calloc(count, sizeof(GameState));
+    env->episodeTicks = calloc(count, sizeof(int));
+    for (int i = 0; i < count; i++) {
+        SeedGame(&env->games[i], seed + i);
+        InitGame(&env->games[i]);
+        StartRound(&env->games[i], difficulty);
+    }
+
+    if (threads < 1) threads = 1;
+    if (threads > count) threads = count > 0 ? count : 1;
+    pthread_mutex_init(&env->lock, NULL);
+    pthread_cond_init(&env->wake, NULL);
+    pthread_cond_init(&env->finished, NULL);
+    env->threads = malloc(threads * sizeof(pthread_t));
+    env->workers = malloc(threads * sizeof(EnvWorker));
+
+    // The caller's thread takes part 0, workers the rest; stop at the first one that fails to start
+    env->parts = 1;
+    for (int t = 1; t < threads; t++) {
+        env->workers[t].env = env;
+        env->workers[t].part = t;
+        if (pthread_create(&env->threads[t], NULL, EnvWorkerLoop, &env->workers[t]) != 0) break;
+        env->parts++;
+    }
+    return env;
+}
+
+void DestroyVecEnv(VecEnv *env) {
+    pthread_mutex_lock(&env->lock);
+    env->quit = true;
+    pthread_cond_broadcast(&env->wake);
+    pthread_mutex_unlock(&env->lock);
+    for (int t = 1; t < env->parts; t++) pthread_join(env->threads[t], NULL);
+
+    pthread_mutex_destroy(&env->lock);
+    pthread_cond_destroy(&env->wake);
+    pthread_cond_destroy(&env->finished);
+    for (int i = 0; i < env->count; i++) CloseGame(&env->games[i]);
+    free(env->games);
+    free(env->episodeTicks);
+    free(env->threads);
+    free(env->workers);
+    free(env);
+}
+
+int VecEnvCount(const VecEnv *env) {
+    return env->count;
+}
+
+int VecEnvThreads(const VecEnv *env) {
+    return env->parts;
+}
+
+GameState *VecEnvGame(VecEnv *env, int index) {
+    return &env->games[index];
+}
+
+void SetVecEnvViews(VecEnv *env, ObsHeader *buffer) {
+    env->views = buffer;
+}
+
+void ResetVecEnv(VecEnv *env, float *observations) {
+    for (int i = 0; i < env->count; i++) {
+        StartRound(&env->games[i], env->difficulty);
+        env->episodeTicks[i] = 0;
+        WriteObservation(&env->games[i], observations + (size_t)i * ENV_OBS_SIZE);
+    }
+    if (env->views != NULL) {
+        WriteObservations(env->views, env->games, 0, env->count);
+        PublishObservations(env->views);
+    }
+}
+
+void StepVecEnv(VecEnv *env, const unsigned char *actions, float *observations, float *rewards,
+                unsigned char *dones) {
+    env->actions = actions;
+    env->observations = observations;
+    env->rewards = rewards;
+    env->dones = dones;
+
+    if (env->parts > 1) {
+        pthread_mutex_lock(&env->lock);
+        env->pending = env->parts - 1;
+        env->generation++;
+        pthread_cond_broadcast(&env->wake);
+        pthread_mutex_unlock(&env->lock);
+    }
+
+    StepSlice(env, 0);
+
+    if (env->parts > 1) {
+        pthread_mutex_lock(&env->lock);
+        while (env->pending > 0) pthread_cond_wait(&env->finished, &env->lock);
+        pthread_mutex_unlock(&env->lock);
+    }
+    if (env->views != NULL) PublishObservations(env->views);
+}
@@ -0,0 +1,48 @@
+#ifndef ENVS_H
+#define ENVS_H
+
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_game.h"
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_observe.h"
+
+// Batched environments for training agents: many independent games stepped in lockstep on a
+// thread pool, headless, with the same movement and collision rules as the game.
+
+// Observation per environment, as fractions of the maze size:
+// player x, y, then enemy and goal positions relative to the player
+#define ENV_OBS_SIZE 6
+
+#define ENV_REWARD_WIN 1.0f
+#define ENV_REWARD_CAUGHT -1.0f
+#define ENV_REWARD_TICK -0.001f // Every other tick, so slow runs score lower
+
+// Why an episode ended (0 while it goes on)
+#define ENV_DONE_WON 1
+#define ENV_DONE_CAUGHT 2
+#define ENV_DONE_TIMEOUT 3
+
+typedef struct VecEnv VecEnv;
+
+// count environments at one difficulty (ACTION_EASY, ACTION_MEDIUM or ACTION_HARD), environment i
+// seeded with seed + i. maxTicks ends an episode that runs too long (0 for no limit). threads
+// includes the caller's; it falls back to fewer if threads cannot be started.
+VecEnv *CreateVecEnv(int count, int threads, unsigned int seed, GameAction difficulty, int maxTicks);
+void DestroyVecEnv(VecEnv *env);
+
+int VecEnvCount(const VecEnv *env);
+int VecEnvThreads(const VecEnv *env);
+GameState *VecEnvGame(VecEnv *env, int index);
+
+// Also write egocentric views into buffer (laid out for this many environments) on every reset
+// and step, each thread its own slice; NULL to stop
+void SetVecEnvViews(VecEnv *env, ObsHeader *buffer);
+
+// Start a new episode everywhere and write count * ENV_OBS_SIZE observations
+void ResetVecEnv(VecEnv *env, float *observations);
+
+// One tick of every environment. actions[i] holds INPUT_ flags for environment i. Writes
+// observations, rewards and done flags (ENV_DONE_) for each; finished episodes restart at once,
+// so the observation after a done is the first of the next episode.
+void StepVecEnv(VecEnv *env, const unsigned char *actions, float *observations, float *rewards,
+                unsigned char *dones);
+
+#endif
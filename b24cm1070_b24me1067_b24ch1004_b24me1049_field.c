@@ -0,0 +1,187 @@
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_field.h"
+#include <math.h>
+#include <stdlib.h>
+
+#define FIELD_FAR 1e20
+#define SLIDE_ITERATIONS 4
+
+// Cell at (cx, cy), anything outside the maze counts as wall
+static bool IsPath(const bool *cells, int cellsWide, int cellsHigh, int cx, int cy) {
+    if (cx < 0 || cy < 0 || cx >= cellsWide || cy >= cellsHigh) return false;
+    return cells[cy * cellsWide + cx];
+}
+
+// 1D squared distance transform of f (lower envelope of parabolas), result in d.
+// v and z are scratch space for n and n + 1 entries.
+static void DistanceTransform1D(const double *f, double *d, int n, int *v, double *z) {
+    int k = 0;
+    v[0] = 0;
+    z[0] = -FIELD_FAR;
+    z[1] = FIELD_FAR;
+
+    for (int q = 1; q < n; q++) {
+        double s = ((f[q] + (double)q * q) - (f[v[k]] + (double)v[k] * v[k])) / (2.0 * (q - v[k]));
+        while (s <= z[k]) {
+            k--;
+            s = ((f[q] + (double)q * q) - (f[v[k]] + (double)v[k] * v[k])) / (2.0 * (q - v[k]));
+        }
+        k++;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = FIELD_FAR;
+    }
+
+    k = 0;
+    for (int q = 0; q < n; q++) {
+        while (z[k + 1] < q) k++;
+        double diff = q - v[k];
+        d[q] = diff * diff + f[v[k]];
+    }
+}
+
+// Squared distance (in samples) from every sample to the nearest source sample, in place.
+// grid holds 0 at sources and FIELD_FAR elsewhere on entry.
+static void DistanceTransform2D(float *grid, int width, int height) {
+    int n = width > height ? width : height;
+    double *f = calloc(n, sizeof(double));
+    double *d = malloc(n * sizeof(double));
+    double *z = malloc((n + 1) * sizeof(double));
+    int *v = malloc(n * sizeof(int));
+
+    for (int x = 0; x < width; x++) {
+        for (int y = 0; y < height; y++) f[y] = grid[y * width + x];
+        DistanceTransform1D(f, d, height, v, z);
+        for (int y = 0; y < height; y++) grid[y * width + x] = (float)d[y];
+    }
+    for (int y = 0; y < height; y++) {
+        float *row = grid + (size_t)y * width;
+        for (int x = 0; x < width; x++) f[x] = row[x];
+        DistanceTransform1D(f, d, width, v, z);
+        for (int x = 0; x < width; x++) row[x] = (float)d[x];
+    }
+
+    free(f);
+    free(d);
+    free(z);
+    free(v);
+}
+
+void BuildDistanceField(DistanceField *field, const bool *cells, int cellsWide, int cellsHigh,
+                        float cellSize, int samplesPerCell) {
+    int width = cellsWide * samplesPerCell + 1;
+    int height = cellsHigh * samplesPerCell + 1;
+    int samples = width * height;
+
+    if (samples > field->allocated) {
+        free(field->dist);
+        free(field->scratch);
+        field->dist = malloc((size_t)samples * sizeof(float));
+        field->scratch = malloc((size_t)samples * sizeof(float));
+        field->allocated = samples;
+    }
+    field->width = width;
+    field->height = height;
+    field->samplesPerCell = samplesPerCell;
+    field->spacing = cellSize / samplesPerCell;
+
+    // A sample on a cell corner or edge touches up to four cells. It is a wall source if it
+    // touches a wall and a path source if it touches a path (boundary samples are both).
+    // Wall edges run along sample lines, so the distances come out exact.
+    for (int sy = 0; sy < height; sy++) {
+        int cy0 = (sy % samplesPerCell == 0) ? sy / samplesPerCell - 1 : sy / samplesPerCell;
+        int cy1 = sy / samplesPerCell;
+        for (int sx = 0; sx < width; sx++) {
+            int cx0 = (sx % samplesPerCell == 0) ? sx / samplesPerCell - 1 : sx / samplesPerCell;
+            int cx1 = sx / samplesPerCell;
+            bool anyPath = false, anyWall = false;
+            for (int cy = cy0; cy <= cy1; cy++) {
+                for (int cx = cx0; cx <= cx1; cx++) {
+                    if (IsPath(cells, cellsWide, cellsHigh, cx, cy)) anyPath = true;
+                    else anyWall = true;
+                }
+            }
+            field->dist[sy * width + sx] = anyWall ? 0 : FIELD_FAR;
+            field->scratch[sy * width + sx] = anyPath ? 0 : FIELD_FAR;
+        }
+    }
+
+    DistanceTransform2D(field->dist, width, height);
+    DistanceTransform2D(field->scratch, width, height);
+
+    for (int i = 0; i < samples; i++) {
+        float toWall = sqrtf(field->dist[i]);
+        float toPath = sqrtf(field->scratch[i]);
+        field->dist[i] = (toWall - toPath) * field->spacing;
+    }
+}
+
+void FreeDistanceField(DistanceField *field) {
+    free(field->dist);
+    free(field->scratch);
+    field->dist = NULL;
+    field->scratch = NULL;
+    field->allocated = 0;
+}
+
+// Sample cell containing (x, y) and the position inside it, clamped to the field
+static const float *FieldCell(const DistanceField *field, float x, float y, float *fx, float *fy) {
+    float gx = x / field->spacing;
+    float gy = y / field->spacing;
+    float maxX = (float)(field->width - 1);
+    float maxY = (float)(field->height - 1);
+    if (gx < 0) gx = 0;
+    if (gy < 0) gy = 0;
+    if (gx > maxX) gx = maxX;
+    if (gy > maxY) gy = maxY;
+
+    int ix = (int)gx;
+    int iy = (int)gy;
+    if (ix >= field->width - 1) ix = field->width - 2;
+    if (iy >= field->height - 1) iy = field->height - 2;
+    *fx = gx - ix;
+    *fy = gy - iy;
+    return field->dist + (size_t)iy * field->width + ix;
+}
+
+float SampleDistanceField(const DistanceField *field, float x, float y) {
+    float fx, fy;
+    const float *d = FieldCell(field, x, y, &fx, &fy);
+    float top = d[0] + (d[1] - d[0]) * fx;
+    float bottom = d[field->width] + (d[field->width + 1] - d[field->width]) * fx;
+    return top + (bottom - top) * fy;
+}
+
+void DistanceFieldGradient(const DistanceField *field, float x, float y, float *gx, float *gy) {
+    float fx, fy;
+    const float *d = FieldCell(field, x, y, &fx, &fy);
+    const float *below = d + field->width;
+    *gx = ((d[1] - d[0]) * (1 - fy) + (below[1] - below[0]) * fy) / field->spacing;
+    *gy = ((below[0] - d[0]) * (1 - fx) + (below[1] - d[1]) * fx) / field->spacing;
+}
+
+bool CircleFits(const DistanceField *field, float x, float y, float radius) {
+    return SampleDistanceField(field, x, y) >= radius;
+}
+
+bool SlideCircle(const DistanceField *field, float *x, float *y, float moveX, float moveY, float radius) {
+    const float tolerance = 0.01f;
+    float nx = *x + moveX;
+    float ny = *y + moveY;
+
+    for (int i = 0; i < SLIDE_ITERATIONS; i++) {
+        float d = SampleDistanceField(field, nx, ny);
+        if (d >= radius - tolerance) {
+            *x = nx;
+            *y = ny;
+            return true;
+        }
+
+        float gx, gy;
+        DistanceFieldGradient(field, nx, ny, &gx, &gy);
+        float length = sqrtf(gx * gx + gy * gy);
+        if (length == 0) break;
+        nx += gx / length * (radius - d);
+        ny += gy / length * (radius - d);
+    }
+    return false;
+}
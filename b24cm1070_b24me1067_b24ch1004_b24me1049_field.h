@@ -0,0 +1,34 @@
+#ifndef FIELD_H
+#define FIELD_H
+
+#include <stdbool.h>
+
+// Signed distance to the nearest wall, sampled at the corners of a sub-cell grid
+// (positive in the corridors, negative inside walls). Rebuilt once per maze.
+typedef struct {
+    int width, height;   // Samples per row / column (cells * samplesPerCell + 1)
+    int samplesPerCell;
+    float spacing;       // Pixels between samples
+    float *dist;         // width * height signed distances in pixels
+    float *scratch;      // Second transform while building
+    int allocated;       // Samples dist and scratch can hold
+} DistanceField;
+
+// Exact Euclidean distance transform of a maze grid (row-major, true = path) in linear time
+// (Felzenszwalb-Huttenlocher, one pass down the columns and one along the rows)
+void BuildDistanceField(DistanceField *field, const bool *cells, int cellsWide, int cellsHigh,
+                        float cellSize, int samplesPerCell);
+void FreeDistanceField(DistanceField *field);
+
+// Bilinear lookup of the distance at a point, and its gradient (points away from walls)
+float SampleDistanceField(const DistanceField *field, float x, float y);
+void DistanceFieldGradient(const DistanceField *field, float x, float y, float *gx, float *gy);
+
+// True if a circle of this radius fits at (x, y)
+bool CircleFits(const DistanceField *field, float x, float y, float radius);
+
+// Move a circle by (moveX, moveY) and push it back out of any wall along the gradient,
+// so blocked moves slide along the wall instead of stopping. Returns false if it could not move.
+bool SlideCircle(const DistanceField *field, float *x, float *y, float moveX, float moveY, float radius);
+
+#endif
@@ -0,0 +1,68 @@
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_fixed.h"
+
+float FixedToFloat(Fixed v) {
+    return (float)v / FIXED_ONE;
+}
+
+uint32_t IntSqrt(uint64_t v) {
+    // Newton's method in integers, so no FPU or libm is involved. It starts from the power of two
+    // just above the root (half the bit length of v) and falls to the exact floor of it in a few
+    // divisions, the same answer on every build.
+    if (v < 2) return (uint32_t)v;
+    int bits = 64 - __builtin_clzll(v);
+    uint64_t root = 1ull << ((bits + 1) / 2);
+    while (1) {
+        uint64_t next = (root + v / root) >> 1;
+        if (next >= root) break;
+        root = next;
+    }
+    return (uint32_t)root;
+}
+
+Fixed FixedLength(Fixed x, Fixed y) {
+    // The square of a 16.16 number is 32.32, so its root is 16.16 again
+    int64_t x2 = (int64_t)x * x, y2 = (int64_t)y * y;
+    return (Fixed)IntSqrt((uint64_t)(x2 + y2));
+}
+
+FixedVec FixedToward(FixedVec from, FixedVec to, Fixed speed) {
+    FixedVec move = {0, 0};
+    Fixed diffX = to.x - from.x;
+    Fixed diffY = to.y - from.y;
+    Fixed distance = FixedLength(diffX, diffY);
+    if (distance > 0) {
+        // Division truncates toward zero, the same either way along an axis
+        move.x = (Fixed)((int64_t)diffX * speed / distance);
+        move.y = (Fixed)((int64_t)diffY * speed / distance);
+    }
+    return move;
+}
+
+bool FixedCanMove(const bool *cells, int width, int cellSize, Fixed x, Fixed y, Fixed radius) {
+    Fixed cell = INT_TO_FIXED(cellSize);
+    int row = y / cell;
+    int col = x / cell;
+    return cells[row * width + (x + radius) / cell] && cells[row * width + (x - radius) / cell] &&
+           cells[(y + radius) / cell * width + col] && cells[(y - radius) / cell * width + col];
+}
+
+// Steps of at most maxStep that cover length
+static int StepCount(Fixed length, Fixed maxStep) {
+    if (length < 0) length = -length;
+    return (length + maxStep - 1) / maxStep;
+}
+
+void FixedStepMove(const bool *cells, int width, int cellSize, Fixed radius, Fixed maxStep, FixedVec *p,
+                   Fixed moveX, Fixed moveY) {
+    int steps = StepCount(moveX, maxStep);
+    int stepsY = StepCount(moveY, maxStep);
+    if (stepsY > steps) steps = stepsY;
+
+    for (int i = 0; i < steps; i++) {
+        // Step i covers [i, i + 1) / steps of the move, so the steps add up to it exactly
+        Fixed stepX = (Fixed)((int64_t)moveX * (i + 1) / steps - (int64_t)moveX * i / steps);
+        Fixed stepY = (Fixed)((int64_t)moveY * (i + 1) / steps - (int64_t)moveY * i / steps);
+        if (stepX != 0 && FixedCanMove(cells, width, cellSize, p->x + stepX, p->y, radius)) p->x += stepX;
+        if (stepY != 0 && FixedCanMove(cells, width, cellSize, p->x, p->y + stepY, radius)) p->y += stepY;
+    }
+}
@@ -0,0 +1,39 @@
+#ifndef FIXED_H
+#define FIXED_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// 16.16 fixed point for the deterministic simulation path: only integer adds, multiplies,
+// divides and shifts, so every compiler, flag set and CPU gets the same bits (float sqrt and
+// division do not, with -ffast-math or x87). Coordinates must stay below 32768 pixels.
+typedef int32_t Fixed;
+
+#define FIXED_SHIFT 16
+#define FIXED_ONE (1 << FIXED_SHIFT)
+#define INT_TO_FIXED(v) ((Fixed)((v) * FIXED_ONE))
+
+typedef struct {
+    Fixed x, y;
+} FixedVec;
+
+float FixedToFloat(Fixed v);
+
+// Largest integer whose square is at most v
+uint32_t IntSqrt(uint64_t v);
+
+// Length of (x, y)
+Fixed FixedLength(Fixed x, Fixed y);
+
+// Move from from toward to, speed long (zero if they are at the same point)
+FixedVec FixedToward(FixedVec from, FixedVec to, Fixed speed);
+
+// CanMove in integers: the four points radius from (x, y) must be path cells (row-major, true = path)
+bool FixedCanMove(const bool *cells, int width, int cellSize, Fixed x, Fixed y, Fixed radius);
+
+// Move by (moveX, moveY) in steps no longer than maxStep on either axis, each axis of each step
+// taken only if FixedCanMove allows it, so long moves cannot pass through a wall
+void FixedStepMove(const bool *cells, int width, int cellSize, Fixed radius, Fixed maxStep, FixedVec *p,
+                   Fixed moveX, Fixed moveY);
+
+#endif
@@ -0,0 +1,112 @@
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_fov.h"
+#include <stdlib.h>
+
+// How each octant's (column, row) maps to maze x and y
+static const int octants[8][4] = {
+    {1, 0, 0, 1}, {0, 1, 1, 0}, {0, -1, 1, 0}, {-1, 0, 0, 1},
+    {-1, 0, 0, -1}, {0, -1, -1, 0}, {0, 1, -1, 0}, {1, 0, 0, -1},
+};
+static size_t Bytes(const FieldOfView *fov) {
+    return (size_t)fov->width * fov->height / 8 + 1;
+}
+
+void InitFieldOfView(FieldOfView *fov, int width, int height, int radius) {
+    *fov = (FieldOfView){0};
+    fov->width = width;
+    fov->height = height;
+    fov->radius = radius;
+    fov->lit = malloc((size_t)(2 * radius + 1) * (2 * radius + 1) * sizeof(size_t));
+    ClearFieldOfView(fov);
+}
+
+void FreeFieldOfView(FieldOfView *fov) {
+    free(fov->inSight);
+    free(fov->explored);
+    free(fov->lit);
+    *fov = (FieldOfView){0};
+}
+
+void ClearFieldOfView(FieldOfView *fov) {
+    // Fresh zeroed memory, which for a huge maze the OS only provides as it is touched
+    free(fov->inSight);
+    free(fov->explored);
+    fov->inSight = calloc(Bytes(fov), 1);
+    fov->explored = calloc(Bytes(fov), 1);
+    fov->litCount = 0;
+    fov->originX = -1;
+    fov->originY = -1;
+}
+
+static bool GetBit(const unsigned char *bits, size_t index) {
+    return bits[index / 8] & (1 << index % 8);
+}
+
+static void See(FieldOfView *fov, int x, int y) {
+    size_t index = (size_t)y * fov->width + x;
+    if (GetBit(fov->inSight, index)) return; // Cells on an octant's edge are scanned twice
+    fov->inSight[index / 8] |= 1 << index % 8;
+    fov->explored[index / 8] |= 1 << index % 8;
+    fov->lit[fov->litCount++] = index;
+}
+
+// Light rows row.. of an octant between two slopes (1 is the diagonal, 0 straight ahead)
+static void CastLight(FieldOfView *fov, const bool *cells, int row, float start, float end, const int *octant) {
+    if (start < end) return;
+    int radius = fov->radius;
+    float nextStart = start;
+    for (int distance = row; distance <= radius; distance++) {
+        bool blocked = false;
+        int dy = -distance;
+        for (int dx = -distance; dx <= 0; dx++) {
+            // The slopes through the corners of this cell
+            float leftSlope = (dx - 0.5f) / (dy + 0.5f);
+            float rightSlope = (dx + 0.5f) / (dy - 0.5f);
+            if (start < rightSlope) continue;
+            if (end > leftSlope) break;
+
+            int x = fov->originX + dx * octant[0] + dy * octant[1];
+            int y = fov->originY + dx * octant[2] + dy * octant[3];
+            if (x < 0 || y < 0 || x >= fov->width || y >= fov->height) continue;
+            if (dx * dx + dy * dy <= radius * radius) See(fov, x, y);
+
+            bool wall = !cells[(size_t)y * fov->width + x];
+            if (blocked) {
+                if (wall) {
+                    nextStart = rightSlope;
+                    continue;
+                }
+                blocked = false;
+                start = nextStart;
+            } else if (wall && distance < radius) {
+                // Light past the wall's near side is another scan, the rest carries on beside it
+                blocked = true;
+                CastLight(fov, cells, distance + 1, start, leftSlope, octant);
+                nextStart = rightSlope;
+            }
+        }
+        if (blocked) break;
+    }
+}
+
+bool UpdateFieldOfView(FieldOfView *fov, const bool *cells, int x, int y) {
+    if (x == fov->originX && y == fov->originY) return false;
+
+    // Clear only what the last origin lit, which in a maze is far less than the square around it
+    for (int i = 0; i < fov->litCount; i++) fov->inSight[fov->lit[i] / 8] &= ~(1 << fov->lit[i] % 8);
+    fov->litCount = 0;
+
+    fov->originX = x;
+    fov->originY = y;
+    See(fov, x, y);
+    for (int i = 0; i < 8; i++) CastLight(fov, cells, 1, 1.0f, 0.0f, octants[i]);
+    fov->computes++;
+    return true;
+}
+
+bool CellInSight(const FieldOfView *fov, int x, int y) {
+    return GetBit(fov->inSight, (size_t)y * fov->width + x);
+}
+
+bool CellExplored(const FieldOfView *fov, int x, int y) {
+    return GetBit(fov->explored, (size_t)y * fov->width + x);
+}
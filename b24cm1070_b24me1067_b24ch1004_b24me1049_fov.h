@@ -0,0 +1,39 @@
+#ifndef FOV_H
+#define FOV_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_view.h"
+
+// How far the player sees in the fog of war, in cells
+#define FOV_RADIUS 8
+
+// The cells in sight of one cell (recursive shadowcasting: each of the eight octants is scanned
+// row by row outwards, and a wall splits the light into the parts on either side of it), and
+// every cell that has been in sight since the maze was made. Computed again only when the
+// origin moves to another cell, at a cost that depends on the radius, not the maze.
+typedef struct {
+    int width, height;        // The maze, in cells
+    int radius;
+    unsigned char *inSight;   // A bit per cell, from the last origin
+    unsigned char *explored;  // A bit per cell, ever in sight
+    size_t *lit;              // The cells in inSight, so the next origin clears just those
+    int litCount;
+    int originX, originY;     // The last origin, -1 before the first
+    long computes;            // Times the view was computed
+} FieldOfView;
+
+void InitFieldOfView(FieldOfView *fov, int width, int height, int radius);
+void FreeFieldOfView(FieldOfView *fov);
+
+// Forget everything explored (a new maze)
+void ClearFieldOfView(FieldOfView *fov);
+
+// The view from cell (x, y) of a maze grid (row-major, true = path, walls block sight), if it
+// is not the cell the view was last computed from. Returns whether it was computed.
+bool UpdateFieldOfView(FieldOfView *fov, const bool *cells, int x, int y);
+
+bool CellInSight(const FieldOfView *fov, int x, int y);
+bool CellExplored(const FieldOfView *fov, int x, int y);
+
+#endif
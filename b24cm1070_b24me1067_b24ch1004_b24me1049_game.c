@@ -0,0 +1,488 @@
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_game.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_simd.h"
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_sweep.h"
+
+typedef struct {
+    int x, y;
+} Node;
+
+// Directions for maze generation (the order to try them in is per game)
+static const int dx[] = {0, 0, -2, 2};
+static const int dy[] = {-2, 2, 0, 0};
+
+// Function to check if a cell is valid for maze generation
+static int isvalid(GameState *game, int x, int y) {
+    return (x > 0 && x < MAZE_WIDTH - 1 && y > 0 && y < MAZE_HEIGHT - 1 && game->maze[y][x] == false);
+}
+
+// Initialize the maze to all walls
+static void initialize(GameState *game) {
+    for (int i = 0; i < MAZE_HEIGHT; i++) {
+        for (int j = 0; j < MAZE_WIDTH; j++) {
+            game->maze[i][j] = false;
+        }
+    }
+}
+
+// Next number from the game's own generator (an LCG, using its better high bits)
+static int GameRandom(GameState *game) {
+    game->randomState = game->randomState * 1664525u + 1013904223u;
+    return (int)(game->randomState >> 9);
+}
+
+void SeedGame(GameState *game, unsigned int seed) {
+    game->seed = seed;
+    game->randomState = seed;
+}
+
+// Shuffle directions for randomness
+static void randomdirection(GameState *game, int arr[], int size) {
+    for (int i = 0; i < size; ++i) {
+        int j = GameRandom(game) % size;
+        int temp = arr[i];
+        arr[i] = arr[j];
+        arr[j] = temp;
+    }
+}
+
+// Maze generation algorithm
+static void SearchAndDestroy(GameState *game, int startX, int startY) {
+    int x = startX, y = startY;
+
+    while (1) {
+        randomdirection(game, game->dir, 4);
+        int found = 0;
+
+        for (int i = 0; i < 4; i++) {
+            int nx = x + dx[game->dir[i]];
+            int ny = y + dy[game->dir[i]];
+
+            if (isvalid(game, nx, ny)) {
+                game->maze[(y + ny) / 2][(x + nx) / 2] = true; // Remove wall
+                game->maze[ny][nx] = true;                    // Mark path
+                x = nx;
+                y = ny;
+                found = 1;
+                break;
+            }
+        }
+
+        if (!found) {
+            int newX = -1, newY = -1;
+
+            for (int i = 1; i < MAZE_HEIGHT; i += 2) {
+                for (int j = 1; j < MAZE_WIDTH; j += 2) {
+                    if (game->maze[i][j] == true) {
+                        for (int s = 0; s < 4; s++) {
+                            int nx = j + dx[s];
+                            int ny = i + dy[s];
+
+                            if (isvalid(game, nx, ny)) {
+                                newX = j;
+                                newY = i;
+                                break;
+                            }
+                        }
+                    }
+                    if (newX != -1) break;
+                }
+                if (newX != -1) break;
+            }
+
+            if (newX == -1) return; // Maze generation complete
+            x = newX;
+            y = newY;
+        }
+    }
+}
+
+// The wall distance field for the current maze, built the first time something slides in it
+// (a 1001x1001 maze takes over a second and about 128 MB, so games that never slide skip it)
+static const DistanceField *MazeField(GameState *game) {
+    SharedGrid *grid = game->grid;
+    if (!grid->fieldBuilt) {
+        BuildDistanceField(&grid->field, grid->cells, MAZE_WIDTH, MAZE_HEIGHT, CELL_SIZE, FIELD_SAMPLES);
+        grid->fieldBuilt = true;
+    }
+    return &grid->field;
+}
+
+// Generate the maze
+void generateMaze(GameState *game) {
+    // Snapshots may still use the old maze, so carve a new one rather than change it under them
+    if (game->grid == NULL || GridIsShared(game->grid)) {
+        ReleaseGrid(game->grid);
+        game->grid = CreateSharedGrid(NULL, MAZE_WIDTH, MAZE_HEIGHT);
+        game->maze = (bool (*)[MAZE_WIDTH])game->grid->cells;
+    }
+    initialize(game);
+    int startX = (GameRandom(game) % ((MAZE_WIDTH - 1) / 2)) * 2 + 1;
+    int startY = (GameRandom(game) % ((MAZE_HEIGHT - 1) / 2)) * 2 + 1;
+
+    game->maze[startY][startX] = true; // Start point
+    SearchAndDestroy(game, startX, startY);
+    game->mazeGeneration++;
+    game->grid->fieldBuilt = false;
+
+    // Build it now when sliding is on, before any snapshot can share the grid with another thread
+    if (game->slideWalls) MazeField(game);
+}
+
+// Put the player and enemy back at their start points (without blending from the old ones)
+static void ResetPositions(GameState *game) {
+    game->player.x = 60;
+    game->player.y = 60;
+    game->enemy.x = CELL_SIZE * (MAZE_WIDTH - 2) - 20;
+    game->enemy.y = CELL_SIZE * (2) - 20;
+    game->prevPlayer = game->player;
+    game->prevEnemy = game->enemy;
+#if FIXED_POINT_FITS
+    game->fixedPlayer = (FixedVec){INT_TO_FIXED(60), INT_TO_FIXED(60)};
+    game->fixedEnemy = (FixedVec){INT_TO_FIXED(CELL_SIZE * (MAZE_WIDTH - 2) - 20), INT_TO_FIXED(CELL_SIZE * (2) - 20)};
+#endif
+}
+
+// Check if the player can move to a new position
+// (a batch of one for CanMoveBatch, which tests many agents at once)
+static bool CanMove(GameState *game, float newX, float newY) {
+    float radius = (CELL_SIZE / 2) - 2;
+    unsigned int allowed;
+    CanMoveBatch(&game->maze[0][0], MAZE_WIDTH, MAZE_HEIGHT, &newX, &newY, 1, CELL_SIZE, radius, &allowed);
+    return allowed & 1;
+}
+
+// The fixed point path: the same moves as below in 16.16 integers. Where the float path sweeps
+// the circle or slides it along the distance field, this one takes short steps along each axis.
+static bool CanMoveFixed(GameState *game, Fixed x, Fixed y) {
+    return FixedCanMove(&game->maze[0][0], MAZE_WIDTH, CELL_SIZE, x, y, INT_TO_FIXED((CELL_SIZE / 2) - 2));
+}
+
+static void StepMoveFixed(GameState *game, FixedVec *p, Fixed moveX, Fixed moveY) {
+    FixedStepMove(&game->maze[0][0], MAZE_WIDTH, CELL_SIZE, INT_TO_FIXED((CELL_SIZE / 2) - 2),
+                  INT_TO_FIXED(PLAYER_SPEED), p, moveX, moveY);
+}
+
+static void MovePlayerFixed(GameState *game, int keys) {
+    FixedVec *player = &game->fixedPlayer;
+    const Fixed speed = INT_TO_FIXED(PLAYER_SPEED);
+    if (game->speedScale > 1) {
+        Fixed step = speed * game->speedScale;
+        Fixed moveX = 0, moveY = 0;
+        if ((keys & INPUT_RIGHT)) moveX += step;
+        if ((keys & INPUT_LEFT)) moveX -= step;
+        if ((keys & INPUT_DOWN)) moveY += step;
+        if ((keys & INPUT_UP)) moveY -= step;
+        StepMoveFixed(game, player, moveX, moveY);
+        return;
+    }
+
+    FixedVec next = *player;
+    if ((keys & INPUT_RIGHT) && CanMoveFixed(game, next.x + speed, next.y)) next.x += speed;
+    if ((keys & INPUT_LEFT) && CanMoveFixed(game, next.x - speed, next.y)) next.x -= speed;
+    if ((keys & INPUT_DOWN) && CanMoveFixed(game, next.x, next.y + speed)) next.y += speed;
+    if ((keys & INPUT_UP) && CanMoveFixed(game, next.x, next.y - speed)) next.y -= speed;
+    *player = next;
+}
+
+// Move the player based on input
+static void MovePlayer(GameState *game, int keys) {
+    Vector2 *player = &game->player;
+    if (game->fixedPoint) {
+        MovePlayerFixed(game, keys);
+        return;
+    }
+    if (game->slideWalls || game->speedScale > 1) {
+        float step = PLAYER_SPEED * game->speedScale;
+        float radius = (CELL_SIZE / 2) - 2;
+        float moveX = 0, moveY = 0;
+        if ((keys & INPUT_RIGHT)) moveX += step;
+        if ((keys & INPUT_LEFT)) moveX -= step;
+        if ((keys & INPUT_DOWN)) moveY += step;
+        if ((keys & INPUT_UP)) moveY -= step;
+
+        // Steps this long could jump a one-cell wall, so sweep the circle instead of testing the end point
+        if (game->speedScale > 1) SweepMove(&game->maze[0][0], MAZE_WIDTH, MAZE_HEIGHT, CELL_SIZE, &player->x, &player->y, moveX, moveY, radius);
+        else SlideCircle(MazeField(game), &player->x, &player->y, moveX, moveY, radius);
+        return;
+    }
+
+    float newX = player->x, newY = player->y;
+    if ((keys & INPUT_RIGHT) && CanMove(game, newX + PLAYER_SPEED, newY)) newX += PLAYER_SPEED;
+    if ((keys & INPUT_LEFT) && CanMove(game, newX - PLAYER_SPEED, newY)) newX -= PLAYER_SPEED;
+    if ((keys & INPUT_DOWN) && CanMove(game, newX, newY + PLAYER_SPEED)) newY += PLAYER_SPEED;
+    if ((keys & INPUT_UP) && CanMove(game, newX, newY - PLAYER_SPEED)) newY -= PLAYER_SPEED;
+    player->x = newX;
+    player->y = newY;
+}
+
+// Move the enemy toward the player
+static void MoveEnemy1(GameState *game) {
+    if(game->medium){
+        game->enemySpeed = 1;
+    }
+    if(game->hard){
+        game->enemySpeed = 2;
+    }
+    if (game->fixedPoint) {
+        FixedVec move = FixedToward(game->fixedEnemy, game->fixedPlayer, INT_TO_FIXED(game->enemySpeed * game->speedScale));
+        game->fixedEnemy.x += move.x;
+        game->fixedEnemy.y += move.y;
+        return;
+    }
+    ChaseBatch(&game->enemy.x, &game->enemy.y, &game->player.x, &game->player.y, 1, game->enemySpeed * game->speedScale);
+}
+
+static void MoveEnemy(GameState *game) {
+    if (game->fixedPoint) {
+        FixedVec move = FixedToward(game->fixedEnemy, game->fixedPlayer, INT_TO_FIXED(game->enemySpeed));
+        StepMoveFixed(game, &game->fixedEnemy, move.x * game->speedScale, move.y * game->speedScale);
+        return;
+    }
+    Vector2 *enemy = &game->enemy;
+    float diffX = game->player.x - enemy->x;
+    float diffY = game->player.y - enemy->y;
+    float distance = sqrt(diffX * diffX + diffY * diffY);
+    if (distance > 0) {
+        float moveX = (diffX / distance) * game->enemySpeed;
+        float moveY = (diffY / distance) * game->enemySpeed;
+        if (game->speedScale > 1) {
+            SweepMove(&game->maze[0][0], MAZE_WIDTH, MAZE_HEIGHT, CELL_SIZE, &enemy->x, &enemy->y,
+                      moveX * game->speedScale, moveY * game->speedScale, (CELL_SIZE / 2) - 2);
+            return;
+        }
+        if (CanMove(game, enemy->x + moveX, enemy->y)) enemy->x += moveX;
+        if (CanMove(game, enemy->x, enemy->y + moveY)) enemy->y += moveY;
+    }
+}
+
+void InitGame(GameState *game) {
+    // Back to the main menu with nothing left over from an earlier game, so a seed replays exactly
+    game->mazeGeneration = 0;
+    game->gameOver = false;
+    game->gameWon = false;
+    game->gamestarted = false;
+    game->showAboutPage = false;
+    game->showsettingpage = false;
+    game->showstartpage = false;
+    game->hard = false;
+    game->easy = false;
+    game->medium = false;
+    game->enemySpeed = 2;
+    if (game->speedScale < 1) game->speedScale = 1;
+    if (!FIXED_POINT_FITS) game->fixedPoint = false; // Its positions would overflow
+    ResetPositions(game);
+    for (int i = 0; i < 4; i++) game->dir[i] = i;
+    game->randomState = game->seed;
+
+    // Pick the instruction set now, not racing other threads on the first tick
+    GetSimdLevel();
+
+    game->grid = NULL;
+    game->tick = 0;
+    game->stateHash = 0;
+    InitSpatialHash(&game->enemyHash, MAZE_WIDTH, MAZE_HEIGHT, CELL_SIZE);
+    generateMaze(game); // Generate the maze
+}
+
+void CloseGame(GameState *game) {
+    FreeSpatialHash(&game->enemyHash);
+    ReleaseGrid(game->grid);
+    game->grid = NULL;
+}
+
+void SnapshotGame(const GameState *game, GameSnapshot *snapshot) {
+    snapshot->state = *game;
+    RetainGrid(game->grid);
+}
+
+void RestoreGame(GameState *game, const GameSnapshot *snapshot) {
+    SpatialHash enemyHash = game->enemyHash;
+    SharedGrid *oldGrid = game->grid;
+    *game = snapshot->state;
+    game->enemyHash = enemyHash;
+    RetainGrid(game->grid);
+    ReleaseGrid(oldGrid);
+}
+
+void FreeSnapshot(GameSnapshot *snapshot) {
+    ReleaseGrid(snapshot->state.grid);
+    snapshot->state.grid = NULL;
+}
+
+// Start a game at one difficulty from the mode page
+static void StartGame(GameState *game, bool *difficulty) {
+    *difficulty = true;
+    game->gamestarted = true;
+    ResetPositions(game);
+    game->gameOver = false;
+    generateMaze(game);
+    game->showstartpage = false;
+}
+
+void StartRound(GameState *game, GameAction difficulty) {
+    game->hard = false;
+    game->easy = false;
+    game->medium = false;
+    game->gameWon = false;
+    game->showAboutPage = false;
+    if (difficulty == ACTION_HARD) StartGame(game, &game->hard);
+    else if (difficulty == ACTION_MEDIUM) StartGame(game, &game->medium);
+    else StartGame(game, &game->easy);
+}
+
+int ApplyGameAction(GameState *game, GameAction action) {
+    bool onMenu = !game->gamestarted && !game->showAboutPage && !game->showstartpage;
+    bool inGame = game->gamestarted && !game->showAboutPage && !game->showstartpage;
+
+    switch (action) {
+        case ACTION_START:
+            if (!onMenu) break;
+            game->showstartpage = true;
+            return EVENT_NEW_TRACK;
+        case ACTION_ABOUT:
+            if (onMenu) game->showAboutPage = true;
+            break;
+        case ACTION_EXIT:
+            if (game->showAboutPage) {
+                game->showAboutPage = false;  // Return to main menu
+            } else if (game->showstartpage) {
+                game->gamestarted = false;
+                game->showstartpage = false;
+            }
+            break;
+        case ACTION_EASY:
+            if (game->showstartpage) StartGame(game, &game->easy);
+            break;
+        case ACTION_MEDIUM:
+            if (game->showstartpage) StartGame(game, &game->medium);
+            break;
+        case ACTION_HARD:
+            if (game->showstartpage) StartGame(game, &game->hard);
+            break;
+        case ACTION_RESTART:
+            if (!inGame) break;
+            if (game->gameWon) {
+                ResetPositions(game);
+                game->gameWon = false;
+                generateMaze(game); // Regenerate the maze
+                return EVENT_NEW_TRACK;
+            }
+            if (game->gameOver) {
+                game->hard = false;
+                game->easy = false;
+                game->medium = false;
+                game->showstartpage = true;
+                return EVENT_NEW_TRACK;
+            }
+            break;
+        default:
+            break;
+    }
+    return 0;
+}
+
+int UpdateGame(GameState *game, int keys) {
+    int events = 0;
+    Vector2 *player = &game->player, *enemy = &game->enemy;
+    game->prevPlayer = *player;
+    game->prevEnemy = *enemy;
+
+    if (!game->gameOver && !game->gameWon) {
+        MovePlayer(game, keys);
+        if (game->easy) {
+            MoveEnemy(game);
+        }
+        if (game->medium) {
+            MoveEnemy1(game);
+        }
+        if (game->hard) {
+            MoveEnemy1(game);
+        }
+    }
+    if (game->fixedPoint) {
+        player->x = FixedToFloat(game->fixedPlayer.x);
+        player->y = FixedToFloat(game->fixedPlayer.y);
+        enemy->x = FixedToFloat(game->fixedEnemy.x);
+        enemy->y = FixedToFloat(game->fixedEnemy.y);
+    }
+
+    // Sliding leaves the player off the 4 pixel grid, so allow anything short of a step (same as == GOAL otherwise).
+    // A step is speedScale times longer at higher speeds, and a shorter window could be stepped over.
+    bool atGoal = false;
+    int reach = PLAYER_SPEED * game->speedScale;
+    if (game->fixedPoint) {
+#if FIXED_POINT_FITS
+        atGoal = abs(game->fixedPlayer.x - INT_TO_FIXED(GOAL_X)) < INT_TO_FIXED(reach) &&
+                 abs(game->fixedPlayer.y - INT_TO_FIXED(GOAL_Y)) < INT_TO_FIXED(reach);
+#endif
+    } else {
+        atGoal = fabsf(player->x - GOAL_X) < reach && fabsf(player->y - GOAL_Y) < reach;
+    }
+    if (atGoal) {
+        events |= EVENT_MAZE_WON | EVENT_NEW_TRACK;
+        ResetPositions(game);
+        generateMaze(game); // Regenerate the maze
+    }
+
+    // Rebuild the enemy grid, push overlapping enemies apart, then look for enemies touching the player
+    // (the one fixed point enemy is tested in integers instead)
+    bool caught;
+    if (game->fixedPoint) {
+        int64_t diffX = game->fixedEnemy.x - game->fixedPlayer.x, diffY = game->fixedEnemy.y - game->fixedPlayer.y;
+        caught = diffX * diffX + diffY * diffY <= (int64_t)INT_TO_FIXED(CELL_SIZE) * INT_TO_FIXED(CELL_SIZE);
+    } else {
+        RebuildSpatialHash(&game->enemyHash, &enemy->x, &enemy->y, 1);
+        SeparateEntities(&game->enemyHash, &enemy->x, &enemy->y, CELL_SIZE);
+        int hit;
+        caught = QuerySpatialHash(&game->enemyHash, &enemy->x, &enemy->y, player->x, player->y, CELL_SIZE, &hit, 1) > 0;
+    }
+    if (caught) {
+        if (!game->gameOver) events |= EVENT_CAUGHT;
+        game->gameOver = true;
+    }
+    return events;
+}
+
+// Fold one 64-bit word into a hash (multiply-xorshift, so every input bit reaches every output bit)
+static uint64_t MixHash(uint64_t hash, uint64_t word) {
+    hash ^= word + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+    hash *= 0xBF58476D1CE4E5B9ull;
+    return hash ^ (hash >> 31);
+}
+
+static uint64_t FloatBits(float a, float b) {
+    uint32_t x, y;
+    memcpy(&x, &a, 4);
+    memcpy(&y, &b, 4);
+    return (uint64_t)x << 32 | y;
+}
+
+uint64_t HashGame(const GameState *game) {
+    uint64_t flags = game->gameOver | game->gameWon << 1 | game->gamestarted << 2 | game->showAboutPage << 3 |
+                     game->showsettingpage << 4 | game->showstartpage << 5 | game->hard << 6 | game->easy << 7 |
+                     game->medium << 8 | game->slideWalls << 9 | game->fixedPoint << 10;
+    uint64_t hash;
+    if (game->fixedPoint) {
+        hash = MixHash(0, (uint64_t)(uint32_t)game->fixedPlayer.x << 32 | (uint32_t)game->fixedPlayer.y);
+        hash = MixHash(hash, (uint64_t)(uint32_t)game->fixedEnemy.x << 32 | (uint32_t)game->fixedEnemy.y);
+    } else {
+        hash = MixHash(0, FloatBits(game->player.x, game->player.y));
+        hash = MixHash(hash, FloatBits(game->enemy.x, game->enemy.y));
+    }
+    hash = MixHash(hash, flags | (uint64_t)game->enemySpeed << 16 | (uint64_t)game->speedScale << 32);
+    hash = MixHash(hash, (uint64_t)game->randomState << 32 | (uint32_t)game->mazeGeneration);
+    return MixHash(hash, (uint64_t)game->dir[0] | game->dir[1] << 2 | game->dir[2] << 4 | game->dir[3] << 6);
+}
+
+int StepGame(GameState *game, GameInput input) {
+    int events = ApplyGameAction(game, (GameAction)input.action);
+    if (game->gamestarted && !game->showAboutPage && !game->showstartpage) {
+        events |= UpdateGame(game, input.keys);
+    }
+    game->tick++;
+    game->stateHash = MixHash(game->stateHash, HashGame(game));
+    return events;
+}
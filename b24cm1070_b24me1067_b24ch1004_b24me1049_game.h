@@ -0,0 +1,140 @@
+#ifndef GAME_H
+#define GAME_H
+
+#include "raylib.h" // Only for Vector2, the game logic makes no raylib calls
+#include <stdbool.h>
+#include <stdint.h>
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_broadphase.h"
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_fixed.h"
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_grid.h"
+
+#define GRID_SIZE 20
+#define CELL_SIZE 40
+#ifndef MAZE_WIDTH // Odd sizes, can be set for the whole build (-DMAZE_WIDTH=401 -DMAZE_HEIGHT=401)
+#define MAZE_WIDTH 19
+#endif
+#ifndef MAZE_HEIGHT
+#define MAZE_HEIGHT 19
+#endif
+#define PLAYER_SPEED 4
+#define FIELD_SAMPLES 4 // Distance field samples per cell edge
+#define TICK_RATE 60    // Simulation ticks per second, whatever the frame rate
+
+// 16.16 fixed point only reaches 32767 pixels, so bigger mazes (over 819 cells a side) have no
+// fixed point path: InitGame turns fixedPoint off there, and --fixed and fixed replays are refused
+#define FIXED_POINT_FITS (CELL_SIZE * MAZE_WIDTH < 32768 && CELL_SIZE * MAZE_HEIGHT < 32768)
+
+// The goal: the middle of the cell inside the bottom right corner
+#define GOAL_X (CELL_SIZE * (MAZE_WIDTH - 2) + CELL_SIZE / 2)
+#define GOAL_Y (CELL_SIZE * (MAZE_HEIGHT - 2) + CELL_SIZE / 2)
+
+// Arrow keys held during a tick
+#define INPUT_RIGHT 1
+#define INPUT_LEFT 2
+#define INPUT_DOWN 4
+#define INPUT_UP 8
+
+// Menu buttons and the restart key
+typedef enum {
+    ACTION_NONE = 0,
+    ACTION_START,
+    ACTION_ABOUT,
+    ACTION_EXIT,
+    ACTION_EASY,
+    ACTION_MEDIUM,
+    ACTION_HARD,
+    ACTION_RESTART
+} GameAction;
+
+// Everything the player can do in one tick
+typedef struct {
+    unsigned char keys;   // INPUT_ flags
+    unsigned char action; // GameAction
+} GameInput;
+
+// What happened during an action or tick (bit flags)
+#define EVENT_NEW_TRACK 1 // Switch to a new random music track
+#define EVENT_MAZE_WON 2
+#define EVENT_CAUGHT 4
+
+// One independent game: everything the rules read or change lives here, so a process can run
+// any number of them side by side (one thread per game at a time). Apart from the maze, which
+// is shared with snapshots, and the enemy grid, which is rebuilt every tick, it is plain data.
+typedef struct {
+    // Maze layout (false = wall, true = path): rows of grid->cells, which also holds the
+    // distance to the nearest wall
+    bool (*maze)[MAZE_WIDTH];
+    SharedGrid *grid;
+    int mazeGeneration; // Bumped every time a maze is generated
+
+    // Player and enemy positions, and where they were before the last tick
+    Vector2 player, enemy;
+    Vector2 prevPlayer, prevEnemy;
+    int enemySpeed;
+
+    bool gameOver;
+    bool gameWon;
+    bool gamestarted;
+    bool showAboutPage;
+    bool showsettingpage;
+    bool showstartpage;
+    bool hard;
+    bool easy;
+    bool medium;
+
+    bool slideWalls; // The player slides along walls instead of stopping
+    int speedScale;  // Everything moves this many times faster, with swept collision
+    bool fixedPoint; // Move in 16.16 fixed point, the same on every build (slideWalls has no effect; needs FIXED_POINT_FITS)
+
+    // The positions when fixedPoint is set; player and enemy are copied from them every tick
+    FixedVec fixedPlayer, fixedEnemy;
+
+    // Maze generation draws from the game's own generator, the same seed and inputs replay the same game
+    unsigned int seed;
+    unsigned int randomState;
+    int dir[4]; // Direction order, shuffled as the maze is carved
+
+    SpatialHash enemyHash; // Enemies binned by cell for the player-vs-enemy and enemy-vs-enemy tests
+
+    long tick;          // Ticks stepped since InitGame
+    uint64_t stateHash; // HashGame of every tick so far chained together, for spotting desyncs
+} GameState;
+
+// A saved game for rollback or lookahead: a flat copy of the GameState that shares the maze
+// instead of copying it. Snapshots of the same maze cost the same whatever its size.
+typedef struct {
+    GameState state; // Its enemyHash is the live game's and is not used
+} GameSnapshot;
+
+// Set the seed InitGame starts the maze generator from
+void SeedGame(GameState *game, unsigned int seed);
+
+// Back to the main menu with a fresh maze from the seed. Set the seed, slideWalls, speedScale and
+// fixedPoint first (a zeroed GameState is fine); the rest is overwritten.
+void InitGame(GameState *game);
+void CloseGame(GameState *game);
+void generateMaze(GameState *game);
+
+// Skip the menus: a new maze at ACTION_EASY, ACTION_MEDIUM or ACTION_HARD, reusing the game's memory
+void StartRound(GameState *game, GameAction difficulty);
+
+// Hash of everything that decides what happens next: positions, flags, speeds, the RNG and
+// which maze is up (the maze follows from those). StepGame chains it into stateHash every tick.
+uint64_t HashGame(const GameState *game);
+
+// Save a game, and put it back exactly as it was (same maze, positions, flags and RNG state).
+// Every snapshot must be freed; the game and snapshot can be freed in any order.
+void SnapshotGame(const GameState *game, GameSnapshot *snapshot);
+void RestoreGame(GameState *game, const GameSnapshot *snapshot);
+void FreeSnapshot(GameSnapshot *snapshot);
+
+// Handle a menu button or the restart key, returns EVENT_ flags
+int ApplyGameAction(GameState *game, GameAction action);
+
+// One fixed simulation tick with the arrow keys held (INPUT_ flags), returns EVENT_ flags
+int UpdateGame(GameState *game, int keys);
+
+// One tick of the whole game: the action first, then the simulation if a game is on screen
+int StepGame(GameState *game, GameInput input);
+
+#endif
@@ -0,0 +1,32 @@
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_grid.h"
+#include <stdlib.h>
+#include <string.h>
+
+SharedGrid *CreateSharedGrid(const bool *cells, int width, int height) {
+    size_t count = (size_t)width * height;
+    SharedGrid *grid = malloc(sizeof(SharedGrid) + count);
+    grid->refs = 1;
+    grid->width = width;
+    grid->height = height;
+    memset(&grid->field, 0, sizeof(grid->field));
+    grid->fieldBuilt = false;
+    if (cells != NULL) memcpy(grid->cells, cells, count);
+    else memset(grid->cells, 0, count);
+    return grid;
+}
+
+// Counts are atomic so snapshots can be handed to other threads
+SharedGrid *RetainGrid(SharedGrid *grid) {
+    __atomic_add_fetch(&grid->refs, 1, __ATOMIC_RELAXED);
+    return grid;
+}
+
+void ReleaseGrid(SharedGrid *grid) {
+    if (grid == NULL || __atomic_sub_fetch(&grid->refs, 1, __ATOMIC_ACQ_REL) > 0) return;
+    FreeDistanceField(&grid->field);
+    free(grid);
+}
+
+bool GridIsShared(const SharedGrid *grid) {
+    return __atomic_load_n(&grid->refs, __ATOMIC_ACQUIRE) > 1;
+}
@@ -0,0 +1,25 @@
+#ifndef GRID_H
+#define GRID_H
+
+#include <stdbool.h>
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_field.h"
+
+// A maze grid (row-major, true = path) and its distance field, shared by reference between a
+// game and its snapshots. Whoever holds the only reference may change it; anyone else makes a
+// new grid first (copy on write).
+typedef struct {
+    int refs;
+    int width, height;
+    DistanceField field; // Built from cells by whoever fills them in, only when something slides
+    bool fieldBuilt;     // field matches cells
+    bool cells[];
+} SharedGrid;
+
+// New grid with one reference, copying cells if given (otherwise all wall)
+SharedGrid *CreateSharedGrid(const bool *cells, int width, int height);
+
+SharedGrid *RetainGrid(SharedGrid *grid);
+void ReleaseGrid(SharedGrid *grid); // Frees the grid with the last reference (NULL is fine)
+bool GridIsShared(const SharedGrid *grid);
+
+#endif
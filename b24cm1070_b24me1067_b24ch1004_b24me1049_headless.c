@@ -0,0 +1,210 @@
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_headless.h"
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_game.h"
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_bench.h"
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_replay.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DEFAULT_AUTOPILOT_TICKS 100000
+
+// One script line: hold keys for count ticks, sending action on the first one
+typedef struct {
+    long count;
+    unsigned char keys;
+    unsigned char action;
+} ScriptLine;
+
+static const char *actionNames[] = {"none", "start", "about", "exit", "easy", "medium", "hard", "restart"};
+
+// Load a script file, returns the number of lines (0 on error)
+static int LoadScript(const char *path, ScriptLine **lines) {
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        printf("Cannot open script: %s\n", path);
+        return 0;
+    }
+
+    int count = 0, capacity = 64;
+    char text[128];
+    *lines = malloc(capacity * sizeof(ScriptLine));
+    while (fgets(text, sizeof(text), file)) {
+        char keys[16] = "-", action[16] = "none";
+        long ticks;
+        if (text[0] == '#' || sscanf(text, "%ld %15s %15s", &ticks, keys, action) < 1 || ticks <= 0) continue;
+
+        ScriptLine line = {ticks, 0, ACTION_NONE};
+        for (char *k = keys; *k; k++) {
+            if (*k == 'R') line.keys |= INPUT_RIGHT;
+            if (*k == 'L') line.keys |= INPUT_LEFT;
+            if (*k == 'D') line.keys |= INPUT_DOWN;
+            if (*k == 'U') line.keys |= INPUT_UP;
+        }
+        for (int a = 0; a <= ACTION_RESTART; a++) {
+            if (strcmp(action, actionNames[a]) == 0) line.action = (unsigned char)a;
+        }
+
+        if (count == capacity) {
+            capacity *= 2;
+            *lines = realloc(*lines, capacity * sizeof(ScriptLine));
+        }
+        (*lines)[count++] = line;
+    }
+    fclose(file);
+    return count;
+}
+
+// Breadth-first search outward from the goal
+static void BuildPath(Autopilot *pilot, const GameState *game) {
+    int *queue = pilot->pathQueue;
+    int head = 0, tail = 0;
+    int goalX = GOAL_X / CELL_SIZE, goalY = GOAL_Y / CELL_SIZE;
+
+    for (int y = 0; y < MAZE_HEIGHT; y++) {
+        for (int x = 0; x < MAZE_WIDTH; x++) pilot->pathSteps[y][x] = -1;
+    }
+    pilot->pathSteps[goalY][goalX] = 0;
+    queue[tail++] = goalY * MAZE_WIDTH + goalX;
+
+    while (head < tail) {
+        int x = queue[head] % MAZE_WIDTH, y = queue[head] / MAZE_WIDTH;
+        head++;
+        const int stepX[] = {1, -1, 0, 0}, stepY[] = {0, 0, 1, -1};
+        for (int s = 0; s < 4; s++) {
+            int nx = x + stepX[s], ny = y + stepY[s];
+            if (nx < 0 || ny < 0 || nx >= MAZE_WIDTH || ny >= MAZE_HEIGHT) continue;
+            if (!game->maze[ny][nx] || pilot->pathSteps[ny][nx] != -1) continue;
+            pilot->pathSteps[ny][nx] = pilot->pathSteps[y][x] + 1;
+            queue[tail++] = ny * MAZE_WIDTH + nx;
+        }
+    }
+}
+
+void ResetAutopilot(Autopilot *pilot) {
+    pilot->pathGeneration = -1;
+    pilot->nextDifficulty = 0;
+}
+
+GameInput AutopilotInput(Autopilot *pilot, const GameState *game) {
+    GameInput input = {0, ACTION_NONE};
+
+    if (!game->gamestarted && !game->showAboutPage && !game->showstartpage) {
+        input.action = ACTION_START;
+        return input;
+    }
+    if (game->showAboutPage) {
+        input.action = ACTION_EXIT;
+        return input;
+    }
+    if (game->showstartpage) {
+        input.action = ACTION_EASY + pilot->nextDifficulty; // Easy, medium and hard in turn
+        pilot->nextDifficulty = (pilot->nextDifficulty + 1) % 3;
+        return input;
+    }
+    if (game->gameOver || game->gameWon) {
+        input.action = ACTION_RESTART;
+        return input;
+    }
+
+    if (pilot->pathGeneration != game->mazeGeneration) {
+        BuildPath(pilot, game);
+        pilot->pathGeneration = game->mazeGeneration;
+        pilot->targetX = game->player.x;
+        pilot->targetY = game->player.y;
+    }
+
+    float arrive = PLAYER_SPEED * game->speedScale * 0.5f;
+    if (fabsf(game->player.x - pilot->targetX) < arrive && fabsf(game->player.y - pilot->targetY) < arrive) {
+        int cx = (int)(game->player.x / CELL_SIZE), cy = (int)(game->player.y / CELL_SIZE);
+        const int stepX[] = {1, -1, 0, 0}, stepY[] = {0, 0, 1, -1};
+        for (int s = 0; s < 4; s++) {
+            int nx = cx + stepX[s], ny = cy + stepY[s];
+            if (pilot->pathSteps[ny][nx] >= 0 && pilot->pathSteps[ny][nx] < pilot->pathSteps[cy][cx]) {
+                pilot->targetX = nx * CELL_SIZE + CELL_SIZE / 2;
+                pilot->targetY = ny * CELL_SIZE + CELL_SIZE / 2;
+                break;
+            }
+        }
+    }
+
+    // Within half a step is close enough, or fast players would hop back and forth over the target
+    if (pilot->targetX > game->player.x + arrive) input.keys |= INPUT_RIGHT;
+    if (pilot->targetX < game->player.x - arrive) input.keys |= INPUT_LEFT;
+    if (pilot->targetY > game->player.y + arrive) input.keys |= INPUT_DOWN;
+    if (pilot->targetY < game->player.y - arrive) input.keys |= INPUT_UP;
+    return input;
+}
+
+int RunHeadless(long ticks, const char *scriptPath) {
+    ScriptLine *script = NULL;
+    int scriptLines = 0;
+    if (scriptPath != NULL) {
+        scriptLines = LoadScript(scriptPath, &script);
+        if (scriptLines == 0) return 1;
+        if (ticks == 0) {
+            for (int i = 0; i < scriptLines; i++) ticks += script[i].count;
+        }
+    } else if (ticks == 0) {
+        ticks = DEFAULT_AUTOPILOT_TICKS;
+    }
+
+    GameState game = {0};
+    Autopilot *pilot = malloc(sizeof(Autopilot));
+    SeedGame(&game, 1); // Same mazes every run, so runs can be compared
+    InitGame(&game);
+    ResetAutopilot(pilot);
+    long wins = 0, caught = 0;
+    int line = 0;
+    long lineTick = 0;
+
+    double start = BenchSeconds();
+    for (long t = 0; t < ticks; t++) {
+        GameInput input;
+        if (script != NULL) {
+            while (lineTick >= script[line].count) {
+                line = (line + 1) % scriptLines; // Loop the script if asked for more ticks
+                lineTick = 0;
+            }
+            input.keys = script[line].keys;
+            input.action = lineTick == 0 ? script[line].action : ACTION_NONE;
+            lineTick++;
+        } else {
+            input = AutopilotInput(pilot, &game);
+        }
+
+        int events = StepGame(&game, input);
+        if (events & EVENT_MAZE_WON) wins++;
+        if (events & EVENT_CAUGHT) caught++;
+    }
+    double elapsed = BenchSeconds() - start;
+
+    printf("headless: %ld ticks in %.3f s = %.0f ticks/s (%.1fx real time), %ld mazes won, caught %ld times\n",
+           ticks, elapsed, ticks / elapsed, ticks / elapsed / TICK_RATE, wins, caught);
+
+    CloseGame(&game);
+    free(pilot);
+    free(script);
+    return 0;
+}
+
+#ifdef HEADLESS_MAIN
+// Stand-alone build for machines without raylib or a display (see the readme)
+int main(int argc, char *argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) return RunBenchmarks(argc > 2 ? argv[2] : NULL);
+    if (argc > 1 && strcmp(argv[1], "--replay") == 0) return RunReplays(argc - 2, argv + 2);
+    if (argc > 3 && strcmp(argv[1], "--hashes") == 0) return RunHashStream(argv[2], argv[3]);
+    if (argc > 3 && strcmp(argv[1], "--desync") == 0) return RunDesync(argv[2], argv[3]);
+
+    // Anything else is "[ticks] [script]"; a flag here is a typo or one this build lacks, not 0 ticks
+    char *end = NULL;
+    long ticks = argc > 1 ? strtol(argv[1], &end, 10) : 0;
+    if (argc > 1 && (argv[1][0] == '-' || *end != '\0')) {
+        printf("Unknown option: %s\n", argv[1]);
+        printf("Usage: %s [ticks] [script] | --bench [name] | --replay [files] | --hashes replay out | --desync replay stream\n",
+               argv[0]);
+        return 1;
+    }
+    return RunHeadless(ticks, argc > 2 ? argv[2] : NULL);
+}
+#endif
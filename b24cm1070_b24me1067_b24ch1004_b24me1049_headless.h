@@ -0,0 +1,30 @@
+#ifndef HEADLESS_H
+#define HEADLESS_H
+
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_game.h"
+
+// Run the game logic as fast as the CPU allows, without a window or audio, and print ticks per second.
+// Input comes from a script file, or from a built-in autopilot that solves each maze if scriptPath is NULL.
+// Script lines are "<ticks> <keys> [action]", keys being any of R L D U (or - for none) and action one of
+// start, about, exit, easy, medium, hard, restart (sent on the first of those ticks only).
+// ticks = 0 runs the whole script, or 100000 ticks of autopilot.
+int RunHeadless(long ticks, const char *scriptPath);
+
+// Autopilot state: steps from every cell to the goal cell, rebuilt for every new maze.
+// It takes 8 bytes per maze cell, so allocate it on the heap (8 MB at 1001x1001).
+typedef struct {
+    int pathGeneration;
+    int pathSteps[MAZE_HEIGHT][MAZE_WIDTH];
+    int pathQueue[MAZE_HEIGHT * MAZE_WIDTH]; // Cells waiting in the search
+    float targetX, targetY; // Centre of the cell the autopilot is heading for
+    int nextDifficulty;
+} Autopilot;
+
+// Input the autopilot gives this tick: click through the menus, restart when caught,
+// otherwise walk cell centre to cell centre along the shortest path
+GameInput AutopilotInput(Autopilot *pilot, const GameState *game);
+
+// Forget the path and start again from easy (call after InitGame)
+void ResetAutopilot(Autopilot *pilot);
+
+#endif
@@ -0,0 +1,128 @@
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_menu.h"
+#include <stddef.h>
+
+// A rounded button and its label
+typedef struct {
+    Rectangle bounds;
+    const char *label;
+    int textX, textY;
+    Color textColor;
+    GameAction action;
+} MenuButton;
+
+// A line of text that is not a button
+typedef struct {
+    const char *text;
+    int x, y, size;
+    Color color;
+} MenuText;
+
+typedef struct {
+    Rectangle box; // Grey panel behind the text, none when zero-sized
+    const MenuText *texts;
+    int textCount;
+    const MenuButton *buttons;
+    int buttonCount;
+} MenuLayout;
+
+// Colours are spelled out: raylib's colour macros are compound literals, which C does not allow in
+// static initializers
+static const MenuButton mainButtons[] = {
+    {{320, 250, 160, 50}, "START", 350, 260, {0, 0, 0, 255}, ACTION_START}, // BLACK
+    {{600, 670, 160, 50}, "ABOUT", 630, 680, {0, 0, 0, 255}, ACTION_ABOUT}, // BLACK
+};
+
+static const MenuText aboutTexts[] = {
+    {"ABOUT THIS GAME", 260, 150, 30, {0, 82, 172, 255}}, // DARKBLUE
+    {"Created by......", 300, 200, 20, {0, 0, 0, 255}}, // BLACK
+    {"Tushar Verma", 220, 320, 20, {255, 109, 194, 255}}, // PINK
+    {"Abhishek Sonparote", 220, 280, 20, {0, 228, 48, 255}}, // GREEN
+    {"Samyag Kothari", 220, 240, 20, {230, 41, 55, 255}}, // RED
+    {"Mrigank Sharma", 220, 360, 20, {0, 121, 241, 255}}, // BLUE
+};
+
+static const MenuButton aboutButtons[] = {
+    {{320, 500, 160, 50}, "EXIT", 360, 510, {0, 0, 0, 255}, ACTION_EXIT}, // BLACK
+};
+
+static const MenuText modeTexts[] = {
+    {"WHAT DO YOU WANT\n TO PLAY (MODE)", 300, 200, 30, {0, 0, 0, 255}}, // BLACK
+};
+
+static const MenuButton modeButtons[] = {
+    {{320, 300, 160, 50}, "HARD", 360, 310, {255, 109, 194, 255}, ACTION_HARD}, // PINK
+    {{310, 400, 180, 50}, "MEDIUM", 340, 410, {0, 228, 48, 255}, ACTION_MEDIUM}, // GREEN
+    {{320, 500, 160, 50}, "EASY", 360, 510, {230, 41, 55, 255}, ACTION_EASY}, // RED
+    {{320, 600, 160, 50}, "EXIT", 360, 610, {0, 0, 0, 255}, ACTION_EXIT}, // BLACK
+};
+
+#define COUNT(array) (int)(sizeof(array) / sizeof(array[0]))
+
+static const MenuLayout layouts[MENU_SCREEN_COUNT] = {
+    [MENU_MAIN] = {{0, 0, 0, 0}, NULL, 0, mainButtons, COUNT(mainButtons)},
+    [MENU_ABOUT] = {{100, 100, 600, 400}, aboutTexts, COUNT(aboutTexts), aboutButtons, COUNT(aboutButtons)},
+    [MENU_MODES] = {{95, 100, 600, 600}, modeTexts, COUNT(modeTexts), modeButtons, COUNT(modeButtons)},
+};
+
+void LoadMenus(MenuCache *menus, int width, int height, Texture2D background) {
+    *menus = (MenuCache){0};
+    menus->background = background;
+    for (int i = 0; i < MENU_SCREEN_COUNT; i++) menus->screens[i] = LoadRenderTexture(width, height);
+}
+
+void UnloadMenus(MenuCache *menus) {
+    for (int i = 0; i < MENU_SCREEN_COUNT; i++) UnloadRenderTexture(menus->screens[i]);
+    TraceLog(LOG_INFO, "Menus composed %ld times", menus->compositions);
+}
+
+MenuScreen MenuScreenOf(const GameState *game) {
+    if (!game->gamestarted && !game->showAboutPage && !game->showstartpage) return MENU_MAIN;
+    if (game->showAboutPage) return MENU_ABOUT;
+    if (game->showstartpage) return MENU_MODES;
+    return MENU_NONE;
+}
+
+// The button of a layout under a point, -1 for none
+static int ButtonAt(const MenuLayout *layout, Vector2 point) {
+    for (int i = 0; i < layout->buttonCount; i++) {
+        if (CheckCollisionPointRec(point, layout->buttons[i].bounds)) return i;
+    }
+    return -1;
+}
+
+static void ComposeMenu(MenuCache *menus, MenuScreen screen, int hovered) {
+    const MenuLayout *layout = &layouts[screen];
+    BeginTextureMode(menus->screens[screen]);
+    ClearBackground(RAYWHITE);
+    if (screen == MENU_MAIN) DrawTexture(menus->background, 0, 0, WHITE);
+    if (layout->box.width > 0) DrawRectangleRec(layout->box, LIGHTGRAY);
+    for (int i = 0; i < layout->textCount; i++) {
+        const MenuText *text = &layout->texts[i];
+        DrawText(text->text, text->x, text->y, text->size, text->color);
+    }
+    for (int i = 0; i < layout->buttonCount; i++) {
+        const MenuButton *button = &layout->buttons[i];
+        DrawRectangleRounded(button->bounds, 0.3f, 10, i == hovered ? SKYBLUE : BLUE);
+        DrawText(button->label, button->textX, button->textY, 30, button->textColor);
+    }
+    EndTextureMode();
+    menus->hovered[screen] = hovered;
+    menus->composed[screen] = true;
+    menus->compositions++;
+}
+
+GameAction UpdateMenu(MenuCache *menus, MenuScreen screen) {
+    if (screen == MENU_NONE) return ACTION_NONE;
+    const MenuLayout *layout = &layouts[screen];
+    int hovered = ButtonAt(layout, GetMousePosition());
+    if (!menus->composed[screen] || hovered != menus->hovered[screen]) ComposeMenu(menus, screen, hovered);
+    if (hovered >= 0 && IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) return layout->buttons[hovered].action;
+    return ACTION_NONE;
+}
+
+void DrawMenu(const MenuCache *menus, MenuScreen screen) {
+    if (screen == MENU_NONE) return;
+    // Render textures are stored bottom row first, a negative height flips them back
+    Texture2D texture = menus->screens[screen].texture;
+    DrawTextureRec(texture, (Rectangle){0, 0, (float)texture.width, -(float)texture.height}, (Vector2){0, 0}, WHITE);
+}
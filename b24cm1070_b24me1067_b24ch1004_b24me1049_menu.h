@@ -0,0 +1,40 @@
+#ifndef MENU_H
+#define MENU_H
+
+#include "raylib.h"
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_game.h"
+
+// The screens shown instead of the maze
+typedef enum {
+    MENU_NONE = -1, // Playing
+    MENU_MAIN = 0,  // Start and about buttons over the background picture
+    MENU_ABOUT,     // Credits
+    MENU_MODES,     // Difficulty choice
+    MENU_SCREEN_COUNT
+} MenuScreen;
+
+// Every menu screen composed into its own texture, and drawn from it as one quad. A screen is
+// only composed again when what it shows changes, which is just the button under the mouse.
+typedef struct {
+    RenderTexture2D screens[MENU_SCREEN_COUNT];
+    int hovered[MENU_SCREEN_COUNT]; // The button highlighted in each texture, -1 for none
+    bool composed[MENU_SCREEN_COUNT];
+    Texture2D background;           // Behind the main screen, owned by the caller
+    long compositions;              // Times a screen was composed, for the log
+} MenuCache;
+
+// Needs the window open. The textures are the size of the window.
+void LoadMenus(MenuCache *menus, int width, int height, Texture2D background);
+void UnloadMenus(MenuCache *menus);
+
+// The screen a game is on
+MenuScreen MenuScreenOf(const GameState *game);
+
+// Compose the screen again if the mouse moved onto or off a button, and return the action of a
+// button clicked this frame (ACTION_NONE if none). Call outside BeginDrawing / EndDrawing.
+GameAction UpdateMenu(MenuCache *menus, MenuScreen screen);
+
+// Draw a screen as composed by the last UpdateMenu
+void DrawMenu(const MenuCache *menus, MenuScreen screen);
+
+#endif
@@ -0,0 +1,59 @@
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_mesh.h"
+#include <stdlib.h>
+#include <string.h>
+
+// A wall cell no rectangle has taken yet
+static bool Uncovered(const WallMesh *mesh, const bool *cells, int index) {
+    return !cells[index] && !mesh->covered[index];
+}
+
+static void AddRect(WallMesh *mesh, WallRect rect) {
+    if (mesh->count == mesh->capacity) {
+        mesh->capacity = mesh->capacity ? mesh->capacity * 2 : 64;
+        mesh->rects = realloc(mesh->rects, mesh->capacity * sizeof(WallRect));
+    }
+    mesh->rects[mesh->count++] = rect;
+}
+
+void BuildWallMesh(WallMesh *mesh, const bool *cells, int width, int height) {
+    int total = width * height;
+    if (total > mesh->allocated) {
+        free(mesh->covered);
+        mesh->covered = malloc(total);
+        mesh->allocated = total;
+    }
+    memset(mesh->covered, 0, total);
+    mesh->count = 0;
+
+    for (int y = 0; y < height; y++) {
+        const int row = y * width;
+        for (int x = 0; x < width; x++) {
+            if (!Uncovered(mesh, cells, row + x)) continue;
+
+            // The longest run along this row, then as many rows down as repeat it
+            int runWidth = 1;
+            while (x + runWidth < width && Uncovered(mesh, cells, row + x + runWidth)) runWidth++;
+            int runHeight = 1;
+            for (; y + runHeight < height; runHeight++) {
+                const int below = (y + runHeight) * width + x;
+                int i = 0;
+                while (i < runWidth && Uncovered(mesh, cells, below + i)) i++;
+                if (i < runWidth) break;
+            }
+
+            for (int dy = 0; dy < runHeight; dy++) memset(mesh->covered + (y + dy) * width + x, 1, runWidth);
+            AddRect(mesh, (WallRect){x, y, runWidth, runHeight});
+            x += runWidth - 1;
+        }
+    }
+}
+
+void FreeWallMesh(WallMesh *mesh) {
+    free(mesh->rects);
+    free(mesh->covered);
+    mesh->rects = NULL;
+    mesh->covered = NULL;
+    mesh->count = 0;
+    mesh->capacity = 0;
+    mesh->allocated = 0;
+}
@@ -0,0 +1,27 @@
+#ifndef MESH_H
+#define MESH_H
+
+#include <stdbool.h>
+
+// A block of wall cells
+typedef struct {
+    int x, y;
+    int width, height;
+} WallRect;
+
+// The walls of a maze grid merged into few rectangles (greedy meshing): each run of wall cells
+// along a row is grown down for as long as the rows below have the same run. Every wall cell
+// is in exactly one rectangle. Rebuilt once per maze.
+typedef struct {
+    WallRect *rects;
+    int count;
+    int capacity;           // Rectangles rects can hold
+    unsigned char *covered; // Cells already in a rectangle, while building
+    int allocated;          // Cells covered can hold
+} WallMesh;
+
+// Mesh a maze grid (row-major, true = path), reusing the mesh's memory
+void BuildWallMesh(WallMesh *mesh, const bool *cells, int width, int height);
+void FreeWallMesh(WallMesh *mesh);
+
+#endif
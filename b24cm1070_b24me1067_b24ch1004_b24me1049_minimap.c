@@ -0,0 +1,90 @@
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_minimap.h"
+#include <stdlib.h>
+#include <string.h>
+
+void InitMinimap(Minimap *map, int width, int height) {
+    int side = width > height ? width : height;
+    *map = (Minimap){0};
+    map->width = width;
+    map->height = height;
+    map->block = (side + MINIMAP_MAX_SIDE - 1) / MINIMAP_MAX_SIDE;
+    map->pixelsWide = (width + map->block - 1) / map->block;
+    map->pixelsHigh = (height + map->block - 1) / map->block;
+    size_t pixels = (size_t)map->pixelsWide * map->pixelsHigh;
+    map->pixels = malloc(pixels * sizeof(Color));
+    map->seen = malloc(pixels * sizeof(int));
+    map->open = malloc(pixels * sizeof(int));
+    ClearMinimap(map);
+}
+
+void FreeMinimap(Minimap *map) {
+    free(map->pixels);
+    free(map->seen);
+    free(map->open);
+    free(map->discovered);
+    *map = (Minimap){0};
+}
+
+void ClearMinimap(Minimap *map) {
+    size_t pixels = (size_t)map->pixelsWide * map->pixelsHigh;
+    memset(map->pixels, 0, pixels * sizeof(Color));
+    memset(map->seen, 0, pixels * sizeof(int));
+    memset(map->open, 0, pixels * sizeof(int));
+    // A fresh allocation rather than clearing: for a huge maze the OS hands out zeroed pages as
+    // they are first touched, so only the parts explored cost memory or time
+    free(map->discovered);
+    map->discovered = calloc((size_t)map->width * map->height / 8 + 1, 1);
+    map->dirty = (CellRange){0, 0, map->pixelsWide - 1, map->pixelsHigh - 1};
+}
+
+static void MarkDirty(Minimap *map, int x, int y) {
+    CellRange *dirty = &map->dirty;
+    if (dirty->maxX < dirty->minX) {
+        *dirty = (CellRange){x, y, x, y};
+        return;
+    }
+    if (x < dirty->minX) dirty->minX = x;
+    if (x > dirty->maxX) dirty->maxX = x;
+    if (y < dirty->minY) dirty->minY = y;
+    if (y > dirty->maxY) dirty->maxY = y;
+}
+
+void RevealCells(Minimap *map, const bool *cells, CellRange range) {
+    for (int y = range.minY; y <= range.maxY; y++) {
+        for (int x = range.minX; x <= range.maxX; x++) {
+            size_t cell = (size_t)y * map->width + x;
+            if (map->discovered[cell / 8] & (1 << cell % 8)) continue;
+            map->discovered[cell / 8] |= 1 << cell % 8;
+
+            // The pixel goes from black to white with the share of its discovered cells that are paths
+            int px = x / map->block, py = y / map->block;
+            int pixel = py * map->pixelsWide + px;
+            map->seen[pixel]++;
+            map->open[pixel] += cells[cell];
+            unsigned char shade = (unsigned char)(255 * map->open[pixel] / map->seen[pixel]);
+            map->pixels[pixel] = (Color){shade, shade, shade, 255};
+            MarkDirty(map, px, py);
+        }
+    }
+}
+
+void RevealAround(Minimap *map, const bool *cells, int x, int y) {
+    CellRange around = {x - MINIMAP_REVEAL, y - MINIMAP_REVEAL, x + MINIMAP_REVEAL, y + MINIMAP_REVEAL};
+    if (around.minX < 0) around.minX = 0;
+    if (around.minY < 0) around.minY = 0;
+    if (around.maxX >= map->width) around.maxX = map->width - 1;
+    if (around.maxY >= map->height) around.maxY = map->height - 1;
+    RevealCells(map, cells, around);
+}
+
+CellRange CopyDirtyPixels(Minimap *map, Color *out) {
+    CellRange dirty = map->dirty;
+    if (dirty.maxX < dirty.minX) return dirty;
+    int columns = dirty.maxX - dirty.minX + 1;
+    for (int y = dirty.minY; y <= dirty.maxY; y++) {
+        memcpy(out, map->pixels + (size_t)y * map->pixelsWide + dirty.minX, columns * sizeof(Color));
+        out += columns;
+    }
+    map->dirty = (CellRange){0, 0, -1, -1};
+    return dirty;
+}
@@ -0,0 +1,43 @@
+#ifndef MINIMAP_H
+#define MINIMAP_H
+
+#include <stdbool.h>
+#include "raylib.h" // Only for Color, no raylib calls
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_view.h"
+
+// Largest minimap side in pixels; bigger mazes put a square block of cells in each pixel
+#define MINIMAP_MAX_SIDE 256
+
+// Cells around the player that count as discovered
+#define MINIMAP_REVEAL 3
+
+// A downsampled picture of the discovered part of a maze, one pixel per cell or per block of
+// cells. Discovering a cell only changes its pixel, and the changed pixels are kept as a
+// rectangle, so the picture is never redrawn whole after it is cleared for a new maze.
+typedef struct {
+    int width, height;           // The maze, in cells
+    int block;                   // Cells along each side of a pixel
+    int pixelsWide, pixelsHigh;
+    Color *pixels;               // Undiscovered pixels are see-through, others from wall to path
+    int *seen, *open;            // Per pixel: cells discovered, and how many of those are paths
+    unsigned char *discovered;   // A bit per cell
+    CellRange dirty;             // Pixels changed since CopyDirtyPixels, empty when none
+} Minimap;
+
+void InitMinimap(Minimap *map, int width, int height);
+void FreeMinimap(Minimap *map);
+
+// Forget everything discovered (a new maze)
+void ClearMinimap(Minimap *map);
+
+// Discover the cells in a range of a maze grid (row-major, true = path)
+void RevealCells(Minimap *map, const bool *cells, CellRange range);
+
+// Discover the cells within MINIMAP_REVEAL of cell (x, y), as the player walks
+void RevealAround(Minimap *map, const bool *cells, int x, int y);
+
+// Copy the changed pixels into out, row after row, and return which they are (empty if none).
+// out then holds exactly the texture update for that rectangle.
+CellRange CopyDirtyPixels(Minimap *map, Color *out);
+
+#endif
@@ -0,0 +1,94 @@
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_observe.h"
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_simd.h"
+#include <math.h>
+#include <string.h>
+
+#define GOAL_CELL_X (GOAL_X / CELL_SIZE)
+#define GOAL_CELL_Y (GOAL_Y / CELL_SIZE)
+
+_Static_assert(sizeof(ObsHeader) == 48, "ObsHeader is shared with other processes, keep its layout");
+
+static int RowBytes(int view, int format) {
+    return format == OBS_BYTES ? view : (view + 7) / 8;
+}
+
+size_t ObservationBufferSize(int count, int view, int format) {
+    return sizeof(ObsHeader) + (size_t)count * OBS_CHANNELS * view * RowBytes(view, format);
+}
+
+ObsHeader *InitObservationBuffer(void *memory, int count, int view, int format) {
+    ObsHeader *buffer = memory;
+    buffer->magic = OBS_MAGIC;
+    buffer->version = OBS_VERSION;
+    buffer->count = count;
+    buffer->view = view;
+    buffer->channels = OBS_CHANNELS;
+    buffer->format = format;
+    buffer->rowBytes = RowBytes(view, format);
+    buffer->envBytes = OBS_CHANNELS * view * buffer->rowBytes;
+    buffer->dataOffset = sizeof(ObsHeader);
+    buffer->step = 0;
+    memset(ObservationData(buffer, 0), 0, (size_t)count * buffer->envBytes);
+    return buffer;
+}
+
+unsigned char *ObservationData(ObsHeader *buffer, int index) {
+    return (unsigned char *)buffer + buffer->dataOffset + (size_t)index * buffer->envBytes;
+}
+
+// Store up to 32 cells of a row starting at column x
+static void PutBits(const ObsHeader *buffer, unsigned char *row, int x, int length, unsigned int bits) {
+    if (buffer->format == OBS_BYTES) {
+        for (int i = 0; i < length; i++) row[x + i] = (bits >> i) & 1;
+        return;
+    }
+    for (int i = 0; i < length; i += 8) row[(x + i) / 8] = (unsigned char)(bits >> i); // x is a multiple of 32
+}
+
+// Mark one cell of a channel, if it is in the window
+static void SetCell(const ObsHeader *buffer, unsigned char *out, int channel, int x, int y) {
+    int view = buffer->view;
+    if (x < 0 || y < 0 || x >= view || y >= view) return;
+    unsigned char *row = out + ((size_t)channel * view + y) * buffer->rowBytes;
+    if (buffer->format == OBS_BYTES) row[x] = 1;
+    else row[x / 8] |= (unsigned char)(1 << (x % 8));
+}
+
+static void WriteView(const ObsHeader *buffer, const GameState *game, unsigned char *out) {
+    const bool *cells = &game->maze[0][0];
+    int view = buffer->view;
+    int left = (int)floorf(game->player.x / CELL_SIZE) - view / 2;
+    int top = (int)floorf(game->player.y / CELL_SIZE) - view / 2;
+    memset(out, 0, buffer->envBytes);
+
+    // Walls: each row of the window is one or more runs of up to 32 maze cells, packed straight
+    // from the grid into bits, with whatever lies outside the maze left as wall
+    for (int r = 0; r < view; r++) {
+        int y = top + r;
+        unsigned char *row = out + ((size_t)OBS_WALLS * view + r) * buffer->rowBytes;
+        for (int c = 0; c < view; c += 32) {
+            int length = view - c < 32 ? view - c : 32;
+            int from = left + c;
+            int lo = from < 0 ? 0 : from;
+            int hi = from + length > MAZE_WIDTH ? MAZE_WIDTH : from + length;
+            unsigned int path = 0;
+            if (y >= 0 && y < MAZE_HEIGHT && lo < hi) {
+                path = PackCellBits(cells, MAZE_WIDTH * MAZE_HEIGHT, y * MAZE_WIDTH + lo, hi - lo) << (lo - from);
+            }
+            unsigned int all = length == 32 ? 0xFFFFFFFFu : (1u << length) - 1;
+            PutBits(buffer, row, c, length, ~path & all);
+        }
+    }
+
+    SetCell(buffer, out, OBS_ENEMY, (int)floorf(game->enemy.x / CELL_SIZE) - left,
+            (int)floorf(game->enemy.y / CELL_SIZE) - top);
+    SetCell(buffer, out, OBS_GOAL, GOAL_CELL_X - left, GOAL_CELL_Y - top);
+}
+
+void WriteObservations(ObsHeader *buffer, const GameState *games, int begin, int end) {
+    for (int i = begin; i < end; i++) WriteView(buffer, &games[i], ObservationData(buffer, i));
+}
+
+void PublishObservations(ObsHeader *buffer) {
+    __atomic_add_fetch(&buffer->step, 1, __ATOMIC_RELEASE);
+}
@@ -0,0 +1,55 @@
+#ifndef OBSERVE_H
+#define OBSERVE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_game.h"
+
+// Egocentric views for agents: a view x view window of maze cells centred on the player's cell,
+// written straight into one shared buffer for every environment. The buffer starts with an
+// ObsHeader and is position-independent, so it can live in a file or shared memory that another
+// process maps. Fields are little-endian, fixed width, and never reordered (bump the version).
+
+#define OBS_MAGIC 0x424F5A4Du // "MZOB"
+#define OBS_VERSION 1
+
+// Channels, in this order for every environment
+#define OBS_WALLS 0 // Wall cells (outside the maze counts as wall)
+#define OBS_ENEMY 1 // The enemy's cell
+#define OBS_GOAL 2  // The goal cell
+#define OBS_CHANNELS 3
+
+// How cells are stored
+#define OBS_BITS 0  // One bit per cell, bit x of a row in byte x / 8 (bit x % 8), rows padded to whole bytes
+#define OBS_BYTES 1 // One byte per cell, 0 or 1
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;       // Environments
+    uint32_t view;        // Cells per side of the window (odd, so the player is in the middle)
+    uint32_t channels;
+    uint32_t format;      // OBS_BITS or OBS_BYTES
+    uint32_t rowBytes;    // Bytes per row of one channel
+    uint32_t envBytes;    // Bytes per environment: channels * view * rowBytes
+    uint64_t dataOffset;  // Where environment 0 starts, from the start of the header
+    uint64_t step;        // Bumped after every complete write, readers can poll it (atomic load)
+} ObsHeader;
+
+// Bytes the whole buffer needs, header included
+size_t ObservationBufferSize(int count, int view, int format);
+
+// Lay out a buffer in caller-owned memory of ObservationBufferSize bytes (aligned for ObsHeader)
+ObsHeader *InitObservationBuffer(void *memory, int count, int view, int format);
+
+// Views of environment index
+unsigned char *ObservationData(ObsHeader *buffer, int index);
+
+// Write the views of games[begin .. end) into environments begin .. end of the buffer.
+// Allocates nothing, so it can run every step from any number of threads on separate ranges.
+void WriteObservations(ObsHeader *buffer, const GameState *games, int begin, int end);
+
+// Bump step once every range of a step has been written, so readers know the views are whole
+void PublishObservations(ObsHeader *buffer);
+
+#endif
@@ -0,0 +1,64 @@
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_quads.h"
+#include <stddef.h>
+
+// Write one untextured quad over [left, right] x [top, bottom]
+static QuadVertex *PutQuad(QuadVertex *out, float left, float top, float right, float bottom, Color color) {
+    out[0] = (QuadVertex){left, top, 0, 0, color};
+    out[1] = (QuadVertex){left, bottom, 0, 0, color};
+    out[2] = (QuadVertex){right, bottom, 0, 0, color};
+    out[3] = (QuadVertex){right, top, 0, 0, color};
+    return out + 4;
+}
+
+int WallRectQuads(QuadVertex *out, const WallRect *rects, int count, CellRange visible, float cellSize) {
+    const Color black = {0, 0, 0, 255};
+    QuadVertex *start = out;
+    for (int i = 0; i < count; i++) {
+        WallRect rect = rects[i];
+        if (rect.x > visible.maxX || rect.y > visible.maxY || rect.x + rect.width <= visible.minX ||
+            rect.y + rect.height <= visible.minY) continue;
+        out = PutQuad(out, (float)rect.x * cellSize, (float)rect.y * cellSize, (float)(rect.x + rect.width) * cellSize,
+                      (float)(rect.y + rect.height) * cellSize, black);
+    }
+    return (int)(out - start) / 4;
+}
+
+int WallCellQuads(QuadVertex *out, const bool *cells, int width, CellRange range, int originX, int originY,
+                  float cellSize) {
+    const Color black = {0, 0, 0, 255};
+    QuadVertex *start = out;
+    for (int y = range.minY; y <= range.maxY; y++) {
+        const bool *row = cells + (size_t)y * width;
+        float top = (float)(y - originY) * cellSize;
+        for (int x = range.minX; x <= range.maxX; x++) {
+            if (row[x]) continue;
+            float left = (float)(x - originX) * cellSize;
+            out = PutQuad(out, left, top, left + cellSize, top + cellSize, black);
+        }
+    }
+    return (int)(out - start) / 4;
+}
+
+int SpriteQuads(QuadVertex *out, const float *x, const float *y, const Color *colors, int count, float radius,
+                Rectangle view) {
+    float left = view.x - radius, right = view.x + view.width + radius;
+    float top = view.y - radius, bottom = view.y + view.height + radius;
+    QuadVertex *start = out;
+    for (int i = 0; i < count; i++) {
+        if (x[i] < left || x[i] > right || y[i] < top || y[i] > bottom) continue;
+        // Vertex colours, so no flush between colours
+        out[0] = (QuadVertex){x[i] - radius, y[i] - radius, 0, 0, colors[i]};
+        out[1] = (QuadVertex){x[i] - radius, y[i] + radius, 0, 1, colors[i]};
+        out[2] = (QuadVertex){x[i] + radius, y[i] + radius, 1, 1, colors[i]};
+        out[3] = (QuadVertex){x[i] + radius, y[i] - radius, 1, 0, colors[i]};
+        out += 4;
+    }
+    return (int)(out - start) / 4;
+}
+
+int GrowBatchCapacity(int capacity, int count, int limit) {
+    if (count <= capacity || capacity >= limit) return capacity;
+    // Doubling, so a rising count reloads the batch only a few times
+    while (capacity < count) capacity *= 2;
+    return capacity > limit ? limit : capacity;
+}
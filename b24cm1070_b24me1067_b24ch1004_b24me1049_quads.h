@@ -0,0 +1,44 @@
+#ifndef QUADS_H
+#define QUADS_H
+
+#include "raylib.h" // Only for Color, no raylib calls
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_mesh.h"
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_view.h"
+
+// The CPU side of drawing: quads written into an array, which the renderer hands to rlgl and the
+// benchmarks time without a window. Corners go top left, bottom left, bottom right, top right,
+// the order RL_QUADS takes them in. Every writer returns how many quads it wrote.
+
+// Quads the wall batch holds, the most 16-bit indices (OpenGL ES / web) can address.
+// Meshes with more rectangles are drawn in this many per draw call.
+#define WALL_BATCH_QUADS 16384
+
+// Most quads the sprite batch grows to outside OpenGL ES, where WALL_BATCH_QUADS is the limit;
+// a bound on the vertex buffers (50k entities still fit in one)
+#define SPRITE_BATCH_MAX (1 << 16)
+
+// One corner of a quad: position, texture coordinate and colour
+typedef struct {
+    float x, y;
+    float u, v;
+    Color color;
+} QuadVertex;
+
+// The rectangles that overlap the visible cells, in black
+int WallRectQuads(QuadVertex *out, const WallRect *rects, int count, CellRange visible, float cellSize);
+
+// A black quad per wall cell of range in a grid width cells wide (row-major, true = path),
+// placed relative to cell (originX, originY)
+int WallCellQuads(QuadVertex *out, const bool *cells, int width, CellRange range, int originX, int originY,
+                  float cellSize);
+
+// A quad of the whole sprite texture, tinted colors[i], for each circle of the radius at (x[i], y[i])
+// that overlaps view
+int SpriteQuads(QuadVertex *out, const float *x, const float *y, const Color *colors, int count, float radius,
+                Rectangle view);
+
+// Quads a batch holding capacity should be reloaded with to draw count in one go: doubled until
+// they fit, up to limit (capacity itself when it already fits or is at the limit)
+int GrowBatchCapacity(int capacity, int count, int limit);
+
+#endif
@@ -0,0 +1,442 @@
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_render.h"
+#include <math.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Wall lookup for WALLS_SHADER. Each fragment samples the middle of its own cell, so filtering
+// never blends two cells and the edges stay sharp at any scale. Two dialects: GLSL 330 for
+// desktop OpenGL 3.3+ (Mesa llvmpipe included), GLSL 100/120 for OpenGL ES 2 / web and 2.1.
+static const char *wallShader330 =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec4 colDiffuse;\n"
+    "uniform vec2 cells;\n"
+    "out vec4 finalColor;\n"
+    "void main() {\n"
+    "    vec2 cell = floor(fragTexCoord * cells);\n"
+    "    float path = texture(texture0, (cell + 0.5) / cells).r;\n"
+    "    finalColor = vec4(0.0, 0.0, 0.0, 1.0 - path) * colDiffuse * fragColor;\n"
+    "}\n";
+
+static const char *wallShader100 =
+    "varying vec2 fragTexCoord;\n"
+    "varying vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec4 colDiffuse;\n"
+    "uniform vec2 cells;\n"
+    "void main() {\n"
+    "    vec2 cell = floor(fragTexCoord * cells);\n"
+    "    float path = texture2D(texture0, (cell + 0.5) / cells).r;\n"
+    "    gl_FragColor = vec4(0.0, 0.0, 0.0, 1.0 - path) * colDiffuse * fragColor;\n"
+    "}\n";
+
+// The wall shader for the context's OpenGL version, false if it has none or it fails to build
+static bool LoadWallShader(MazeRenderer *renderer) {
+    char code[1024];
+    switch (rlGetVersion()) {
+        case RL_OPENGL_33:
+        case RL_OPENGL_43:
+            renderer->shader = LoadShaderFromMemory(NULL, wallShader330);
+            break;
+        case RL_OPENGL_21:
+            snprintf(code, sizeof(code), "#version 120\n%s", wallShader100);
+            renderer->shader = LoadShaderFromMemory(NULL, code);
+            break;
+        case RL_OPENGL_ES_20:
+        case RL_OPENGL_ES_30:
+            // Large mazes have more cells across than mediump can tell apart
+            snprintf(code, sizeof(code),
+                     "#version 100\n#ifdef GL_FRAGMENT_PRECISION_HIGH\nprecision highp float;\n#else\n"
+                     "precision mediump float;\n#endif\n%s", wallShader100);
+            renderer->shader = LoadShaderFromMemory(NULL, code);
+            break;
+        default:
+            return false;
+    }
+    // A shader that fails to compile comes back as the default one
+    if (!IsShaderValid(renderer->shader) || renderer->shader.id == rlGetShaderIdDefault()) return false;
+    renderer->cellsLoc = GetShaderLocation(renderer->shader, "cells");
+    float cells[2] = {MAZE_WIDTH, MAZE_HEIGHT};
+    SetShaderValue(renderer->shader, renderer->cellsLoc, cells, SHADER_UNIFORM_VEC2);
+    return true;
+}
+
+static void LoadCellTexture(MazeRenderer *renderer) {
+    renderer->texels = calloc(MAZE_WIDTH * MAZE_HEIGHT, 1);
+    Image image = {renderer->texels, MAZE_WIDTH, MAZE_HEIGHT, 1, PIXELFORMAT_UNCOMPRESSED_GRAYSCALE};
+    renderer->cells = LoadTextureFromImage(image);
+    SetTextureFilter(renderer->cells, TEXTURE_FILTER_POINT);
+    SetTextureWrap(renderer->cells, TEXTURE_WRAP_CLAMP);
+}
+
+void LoadMazeRenderer(MazeRenderer *renderer, WallMode mode) {
+    *renderer = (MazeRenderer){0};
+    if (mode == WALLS_SHADER && (MAZE_WIDTH > WALL_TEXTURE_MAX || MAZE_HEIGHT > WALL_TEXTURE_MAX)) mode = WALLS_CHUNKS;
+    if (mode == WALLS_TEXTURE && (MAZE_WIDTH * CELL_SIZE > WALL_TEXTURE_MAX || MAZE_HEIGHT * CELL_SIZE > WALL_TEXTURE_MAX)) {
+        mode = WALLS_CHUNKS;
+    }
+    if (mode == WALLS_SHADER && !LoadWallShader(renderer)) {
+        TraceLog(LOG_WARNING, "Maze shader unavailable, drawing the walls from a texture");
+        mode = WALLS_TEXTURE;
+    }
+    renderer->mode = mode;
+    if (mode == WALLS_TEXTURE) renderer->walls = LoadRenderTexture(MAZE_WIDTH * CELL_SIZE, MAZE_HEIGHT * CELL_SIZE);
+    if (mode == WALLS_MESH) renderer->batch = rlLoadRenderBatch(1, WALL_BATCH_QUADS);
+    if (mode == WALLS_SHADER) LoadCellTexture(renderer);
+    renderer->mazeGeneration = -1;
+}
+
+void UnloadMazeRenderer(MazeRenderer *renderer) {
+    switch (renderer->mode) {
+        case WALLS_TEXTURE:
+            UnloadRenderTexture(renderer->walls);
+            break;
+        case WALLS_MESH:
+            rlUnloadRenderBatch(renderer->batch);
+            FreeWallMesh(&renderer->mesh);
+            break;
+        case WALLS_SHADER:
+            UnloadTexture(renderer->cells);
+            UnloadShader(renderer->shader);
+            free(renderer->texels);
+            renderer->texels = NULL;
+            break;
+        case WALLS_CELLS:
+            break;
+        case WALLS_CHUNKS:
+            for (int i = 0; i < CHUNK_CACHE_SLOTS; i++) {
+                if (renderer->chunkTextures[i].id != 0) UnloadRenderTexture(renderer->chunkTextures[i]);
+                renderer->chunkTextures[i] = (RenderTexture2D){0};
+            }
+            ClearChunkCache(&renderer->chunks);
+            break;
+    }
+    free(renderer->quads);
+    renderer->quads = NULL;
+    renderer->quadCapacity = 0;
+    renderer->grid = NULL;
+}
+
+// A quad array grown to hold at least count quads
+static QuadVertex *GrowQuads(QuadVertex **quads, int *capacity, int count) {
+    if (count > *capacity) {
+        int grown = *capacity ? *capacity : 256;
+        while (grown < count) grown *= 2;
+        *quads = realloc(*quads, (size_t)grown * 4 * sizeof(QuadVertex));
+        *capacity = grown;
+    }
+    return *quads;
+}
+
+// The renderer's quad array, grown to hold at least count quads
+static QuadVertex *QuadBuffer(MazeRenderer *renderer, int count) {
+    return GrowQuads(&renderer->quads, &renderer->quadCapacity, count);
+}
+
+// Quads from quads.c into the active batch, which draws them when it fills up or is put away
+static void SubmitQuads(const QuadVertex *quads, int count) {
+    rlBegin(RL_QUADS);
+    for (int i = 0; i < count * 4; i++) {
+        rlColor4ub(quads[i].color.r, quads[i].color.g, quads[i].color.b, quads[i].color.a);
+        rlTexCoord2f(quads[i].u, quads[i].v);
+        rlVertex2f(quads[i].x, quads[i].y);
+    }
+    rlEnd();
+}
+
+// Draw the walls of one chunk into its slot's texture, making the texture the first time
+static void BuildChunk(MazeRenderer *renderer, int slot, int chunkX, int chunkY) {
+    RenderTexture2D *texture = &renderer->chunkTextures[slot];
+    if (texture->id == 0) *texture = LoadRenderTexture(CHUNK_CELLS * CELL_SIZE, CHUNK_CELLS * CELL_SIZE);
+    CellRange cells = ChunkCells(chunkX, chunkY, MAZE_WIDTH, MAZE_HEIGHT);
+    const bool *maze = renderer->grid->cells;
+
+    // The CPU side only: the GPU draws it later, in its own time
+    double start = GetTime();
+    BeginTextureMode(*texture);
+    ClearBackground(BLANK);
+    QuadVertex *quads = QuadBuffer(renderer, CHUNK_CELLS * CHUNK_CELLS);
+    SubmitQuads(quads, WallCellQuads(quads, maze, MAZE_WIDTH, cells, cells.minX, cells.minY, CELL_SIZE));
+    EndTextureMode();
+    renderer->chunks.buildSeconds += GetTime() - start;
+}
+
+// Look up every chunk in view, building the ones the cache does not have
+static void UpdateChunks(MazeRenderer *renderer, CellRange visible) {
+    CellRange chunks = ChunksOf(visible);
+    for (int y = chunks.minY; y <= chunks.maxY; y++) {
+        for (int x = chunks.minX; x <= chunks.maxX; x++) {
+            bool build;
+            int slot = LookupChunk(&renderer->chunks, x, y, &build);
+            if (build) BuildChunk(renderer, slot, x, y);
+        }
+    }
+}
+
+void UpdateMazeRenderer(MazeRenderer *renderer, const GameState *game, CellRange visible) {
+    bool changed = game->grid != renderer->grid || game->mazeGeneration != renderer->mazeGeneration;
+    renderer->grid = game->grid;
+    renderer->mazeGeneration = game->mazeGeneration;
+    if (renderer->mode == WALLS_CHUNKS) {
+        if (changed) ClearChunkCache(&renderer->chunks); // Built again as they come into view
+        UpdateChunks(renderer, visible);
+        return;
+    }
+    if (!changed) return;
+
+    if (renderer->mode == WALLS_CELLS) return; // Read straight from the grid every frame
+    if (renderer->mode == WALLS_MESH) {
+        BuildWallMesh(&renderer->mesh, &game->maze[0][0], MAZE_WIDTH, MAZE_HEIGHT);
+        return;
+    }
+    if (renderer->mode == WALLS_SHADER) {
+        // A new maze is a few hundred bytes of texture, not new geometry
+        const bool *cells = &game->maze[0][0];
+        for (int i = 0; i < MAZE_WIDTH * MAZE_HEIGHT; i++) renderer->texels[i] = cells[i] ? 255 : 0;
+        UpdateTexture(renderer->cells, renderer->texels);
+        return;
+    }
+    BeginTextureMode(renderer->walls);
+    ClearBackground(BLANK); // Paths stay see-through, so the screen behind shows
+    for (int y = 0; y < MAZE_HEIGHT; y++) {
+        for (int x = 0; x < MAZE_WIDTH; x++) {
+            if (game->maze[y][x] == false) {
+                DrawRectangle(x * CELL_SIZE, y * CELL_SIZE, CELL_SIZE, CELL_SIZE, BLACK);
+            }
+        }
+    }
+    EndTextureMode();
+}
+
+// Every visible rectangle as a quad in the wall batch
+static void DrawWallMesh(MazeRenderer *renderer, CellRange visible) {
+    QuadVertex *quads = QuadBuffer(renderer, renderer->mesh.count);
+    int count = WallRectQuads(quads, renderer->mesh.rects, renderer->mesh.count, visible, CELL_SIZE);
+    rlSetRenderBatchActive(&renderer->batch); // Draws what the default batch had so far
+    SubmitQuads(quads, count);
+    rlSetRenderBatchActive(NULL);
+}
+
+void DrawMazeWalls(MazeRenderer *renderer, CellRange visible) {
+    if (renderer->grid == NULL || visible.maxX < visible.minX || visible.maxY < visible.minY) return;
+    int columns = visible.maxX - visible.minX + 1, rows = visible.maxY - visible.minY + 1;
+    Vector2 corner = {(float)visible.minX * CELL_SIZE, (float)visible.minY * CELL_SIZE};
+
+    switch (renderer->mode) {
+        case WALLS_MESH:
+            DrawWallMesh(renderer, visible);
+            break;
+        case WALLS_SHADER: {
+            // The visible cells of the cell texture stretched over them, the shader turns texels into walls
+            Rectangle source = {(float)visible.minX, (float)visible.minY, (float)columns, (float)rows};
+            Rectangle dest = {corner.x, corner.y, (float)columns * CELL_SIZE, (float)rows * CELL_SIZE};
+            BeginShaderMode(renderer->shader);
+            DrawTexturePro(renderer->cells, source, dest, (Vector2){0, 0}, 0, WHITE);
+            EndShaderMode();
+            break;
+        }
+        case WALLS_CELLS: {
+            QuadVertex *quads = QuadBuffer(renderer, columns * rows);
+            SubmitQuads(quads, WallCellQuads(quads, renderer->grid->cells, MAZE_WIDTH, visible, 0, 0, CELL_SIZE));
+            break;
+        }
+        case WALLS_CHUNKS: {
+            // Whole chunks, flipped like the wall texture below; cells past the maze edge are see-through
+            CellRange chunks = ChunksOf(visible);
+            float side = CHUNK_CELLS * CELL_SIZE;
+            for (int y = chunks.minY; y <= chunks.maxY; y++) {
+                for (int x = chunks.minX; x <= chunks.maxX; x++) {
+                    int slot = FindChunk(&renderer->chunks, x, y);
+                    if (slot < 0) continue; // Not given to UpdateMazeRenderer
+                    Vector2 position = {x * side, y * side};
+                    DrawTextureRec(renderer->chunkTextures[slot].texture, (Rectangle){0, 0, side, -side}, position, WHITE);
+                }
+            }
+            break;
+        }
+        case WALLS_TEXTURE: {
+            // Render textures are stored bottom row first, so take the rows from the bottom and
+            // flip them back with a negative height
+            Texture2D texture = renderer->walls.texture;
+            Rectangle source = {corner.x, texture.height - corner.y - (float)rows * CELL_SIZE, (float)columns * CELL_SIZE,
+                                -(float)rows * CELL_SIZE};
+            DrawTextureRec(texture, source, corner, WHITE);
+            break;
+        }
+    }
+}
+
+void DrawFogOfWar(const FieldOfView *fov, const bool *cells, CellRange visible) {
+    if (visible.maxX < visible.minX || visible.maxY < visible.minY) return;
+    int columns = visible.maxX - visible.minX + 1, rows = visible.maxY - visible.minY + 1;
+    DrawRectangle(visible.minX * CELL_SIZE, visible.minY * CELL_SIZE, columns * CELL_SIZE, rows * CELL_SIZE, DARKGRAY);
+    for (int y = visible.minY; y <= visible.maxY; y++) {
+        for (int x = visible.minX; x <= visible.maxX; x++) {
+            if (!CellExplored(fov, x, y)) continue;
+            Color color = BLACK;
+            if (cells[y * MAZE_WIDTH + x]) color = CellInSight(fov, x, y) ? RAYWHITE : LIGHTGRAY;
+            DrawRectangle(x * CELL_SIZE, y * CELL_SIZE, CELL_SIZE, CELL_SIZE, color);
+        }
+    }
+}
+
+void LogChunkStats(const MazeRenderer *renderer) {
+    const ChunkCache *cache = &renderer->chunks;
+    long lookups = cache->hits + cache->misses;
+    if (renderer->mode != WALLS_CHUNKS || lookups == 0) return;
+    TraceLog(LOG_INFO, "Maze chunks: %ld lookups, %.2f%% hits, %ld builds at %.3f ms each, %ld evictions", lookups,
+             100.0 * cache->hits / lookups, cache->misses, cache->buildSeconds * 1e3 / (cache->misses ? cache->misses : 1),
+             cache->evictions);
+}
+
+// Most quads one batch can hold: 16-bit indices on OpenGL ES, and a limit on the vertex
+// buffers everywhere else
+static int SpriteBatchLimit(void) {
+    int version = rlGetVersion();
+    return version == RL_OPENGL_ES_20 || version == RL_OPENGL_ES_30 ? WALL_BATCH_QUADS : SPRITE_BATCH_MAX;
+}
+
+void LoadSpriteBatch(SpriteBatch *sprites) {
+    // The edge pixels are as opaque as they are covered, so the circle stays round when scaled
+    Image image = GenImageColor(SPRITE_SIZE, SPRITE_SIZE, BLANK);
+    Color *pixels = image.data;
+    float centre = SPRITE_SIZE / 2.0f;
+    for (int y = 0; y < SPRITE_SIZE; y++) {
+        for (int x = 0; x < SPRITE_SIZE; x++) {
+            float distance = sqrtf((x + 0.5f - centre) * (x + 0.5f - centre) + (y + 0.5f - centre) * (y + 0.5f - centre));
+            float coverage = fminf(fmaxf(centre - distance + 0.5f, 0), 1);
+            pixels[y * SPRITE_SIZE + x] = (Color){255, 255, 255, (unsigned char)(coverage * 255)};
+        }
+    }
+    sprites->circle = LoadTextureFromImage(image);
+    UnloadImage(image);
+    GenTextureMipmaps(&sprites->circle); // Entities far smaller than the sprite stay smooth
+    SetTextureFilter(sprites->circle, TEXTURE_FILTER_TRILINEAR);
+    sprites->capacity = 1024;
+    sprites->batch = rlLoadRenderBatch(1, sprites->capacity);
+    sprites->quads = NULL;
+    sprites->quadCapacity = 0;
+}
+
+void UnloadSpriteBatch(SpriteBatch *sprites) {
+    rlUnloadRenderBatch(sprites->batch);
+    UnloadTexture(sprites->circle);
+    sprites->capacity = 0;
+    free(sprites->quads);
+    sprites->quads = NULL;
+    sprites->quadCapacity = 0;
+}
+
+void DrawSprites(SpriteBatch *sprites, const float *x, const float *y, const Color *colors, int count, float radius,
+                 Rectangle view) {
+    int capacity = GrowBatchCapacity(sprites->capacity, count, SpriteBatchLimit());
+    if (capacity != sprites->capacity) {
+        rlUnloadRenderBatch(sprites->batch);
+        sprites->batch = rlLoadRenderBatch(1, capacity);
+        sprites->capacity = capacity;
+    }
+
+    // More than the batch holds (OpenGL ES) is drawn a full batch at a time, as rlgl does when it fills up
+    QuadVertex *quads = GrowQuads(&sprites->quads, &sprites->quadCapacity, count);
+    int drawn = SpriteQuads(quads, x, y, colors, count, radius, view);
+    rlSetRenderBatchActive(&sprites->batch); // Draws what the default batch had so far
+    rlSetTexture(sprites->circle.id);
+    SubmitQuads(quads, drawn);
+    rlSetTexture(0);
+    rlSetRenderBatchActive(NULL);
+}
+
+void LoadMinimapRenderer(MinimapRenderer *minimap) {
+    InitMinimap(&minimap->map, MAZE_WIDTH, MAZE_HEIGHT);
+    Minimap *map = &minimap->map;
+    Image image = {map->pixels, map->pixelsWide, map->pixelsHigh, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8};
+    minimap->texture = LoadTextureFromImage(image);
+    SetTextureFilter(minimap->texture, TEXTURE_FILTER_POINT);
+    minimap->staging = malloc((size_t)map->pixelsWide * map->pixelsHigh * sizeof(Color));
+    minimap->grid = NULL;
+    minimap->mazeGeneration = -1;
+}
+
+void UnloadMinimapRenderer(MinimapRenderer *minimap) {
+    UnloadTexture(minimap->texture);
+    FreeMinimap(&minimap->map);
+    free(minimap->staging);
+    minimap->staging = NULL;
+}
+
+void UpdateMinimapRenderer(MinimapRenderer *minimap, const GameState *game) {
+    if (game->grid != minimap->grid || game->mazeGeneration != minimap->mazeGeneration) {
+        ClearMinimap(&minimap->map);
+        minimap->grid = game->grid;
+        minimap->mazeGeneration = game->mazeGeneration;
+    }
+    RevealAround(&minimap->map, game->grid->cells, (int)(game->player.x / CELL_SIZE), (int)(game->player.y / CELL_SIZE));
+
+    CellRange dirty = CopyDirtyPixels(&minimap->map, minimap->staging);
+    if (dirty.maxX < dirty.minX) return;
+    Rectangle rect = {(float)dirty.minX, (float)dirty.minY, (float)(dirty.maxX - dirty.minX + 1),
+                      (float)(dirty.maxY - dirty.minY + 1)};
+    UpdateTextureRec(minimap->texture, rect, minimap->staging);
+}
+
+void DrawMinimap(const MinimapRenderer *minimap, Rectangle dest, Vector2 player, Vector2 enemy) {
+    const Minimap *map = &minimap->map;
+    DrawRectangleRec(dest, Fade(DARKGRAY, 0.6f)); // Undiscovered
+    Rectangle source = {0, 0, (float)map->pixelsWide, (float)map->pixelsHigh};
+    DrawTexturePro(minimap->texture, source, dest, (Vector2){0, 0}, 0, WHITE);
+
+    // Positions in pixels of the minimap, which may not cover whole blocks at the far edges
+    float scaleX = dest.width / (map->pixelsWide * map->block * (float)CELL_SIZE);
+    float scaleY = dest.height / (map->pixelsHigh * map->block * (float)CELL_SIZE);
+    DrawRectangle((int)(dest.x + GOAL_X * scaleX) - 2, (int)(dest.y + GOAL_Y * scaleY) - 2, 5, 5, GREEN);
+    DrawCircleV((Vector2){dest.x + player.x * scaleX, dest.y + player.y * scaleY}, 3, BLUE);
+    DrawCircleV((Vector2){dest.x + enemy.x * scaleX, dest.y + enemy.y * scaleY}, 3, RED);
+}
+
+void LoadSceneTarget(SceneTarget *scene, int width, int height, int scale) {
+    *scene = (SceneTarget){0};
+    scene->width = width;
+    scene->height = height;
+    scene->scale = 100;
+    SetSceneScale(scene, scale);
+}
+
+void UnloadSceneTarget(SceneTarget *scene) {
+    if (scene->target.id != 0) UnloadRenderTexture(scene->target);
+    scene->target = (RenderTexture2D){0};
+}
+
+void SetSceneScale(SceneTarget *scene, int scale) {
+    if (scale < 10) scale = 10;
+    if (scale > 100) scale = 100;
+    UnloadSceneTarget(scene);
+    scene->scale = scale;
+    if (scale == 100) return; // Straight to the window
+    scene->target = LoadRenderTexture(scene->width * scale / 100, scene->height * scale / 100);
+    SetTextureFilter(scene->target.texture, TEXTURE_FILTER_BILINEAR);
+}
+
+void BeginScene(SceneTarget *scene, Camera2D camera) {
+    if (scene->scale < 100) {
+        // The same view of the world, shrunk to the texture
+        float factor = scene->scale / 100.0f;
+        camera.offset = (Vector2){camera.offset.x * factor, camera.offset.y * factor};
+        camera.zoom *= factor;
+        BeginTextureMode(scene->target);
+        ClearBackground(RAYWHITE);
+    }
+    BeginMode2D(camera);
+}
+
+void EndScene(SceneTarget *scene) {
+    EndMode2D();
+    if (scene->scale == 100) return;
+    EndTextureMode();
+    Texture2D texture = scene->target.texture;
+    Rectangle source = {0, 0, (float)texture.width, -(float)texture.height}; // Stored bottom row first
+    Rectangle dest = {0, 0, (float)scene->width, (float)scene->height};
+    DrawTexturePro(texture, source, dest, (Vector2){0, 0}, 0, WHITE);
+}
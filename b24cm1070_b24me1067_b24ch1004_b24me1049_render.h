@@ -0,0 +1,130 @@
+#ifndef RENDER_H
+#define RENDER_H
+
+#include "raylib.h"
+#include "rlgl.h"
+#include <stdbool.h>
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_game.h"
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_mesh.h"
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_view.h"
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_chunks.h"
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_minimap.h"
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_fov.h"
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_quads.h"
+
+// Largest texture side the renderer asks for; bigger mazes are drawn in chunks
+#define WALL_TEXTURE_MAX 8192
+
+// How the walls are drawn
+typedef enum {
+    WALLS_TEXTURE = 0, // Drawn once into a texture the size of the maze, which every frame draws
+    WALLS_MESH,        // Merged into rectangles once per maze (WallMesh), all sent every frame in one batch
+    WALLS_SHADER,      // One texel per cell, one quad over the maze whose fragment shader looks up the cell
+    WALLS_CELLS,       // A rectangle per visible wall cell, nothing cached (any maze size)
+    WALLS_CHUNKS       // Square chunks each drawn into a texture when first seen, the recently seen ones kept (any maze size)
+} WallMode;
+
+// Draws the maze walls. They only change when a maze is generated, so everything is built
+// then and a frame costs one quad (texture, shader) or one per rectangle (mesh), not one per cell.
+typedef struct {
+    WallMode mode;
+    RenderTexture2D walls;
+    WallMesh mesh;
+    rlRenderBatch batch;    // For the mesh, WALL_BATCH_QUADS at a time
+    QuadVertex *quads;      // The quads of a draw, written before they go to rlgl
+    int quadCapacity;       // Quads it holds
+    Texture2D cells;        // For the shader: 255 for a path cell, 0 for a wall
+    unsigned char *texels;  // The next upload to cells
+    Shader shader;
+    int cellsLoc;           // Its "cells" uniform, the maze size in cells
+    const SharedGrid *grid; // The maze the walls were built from, and which generation of it
+    int mazeGeneration;
+    ChunkCache chunks;      // For the chunks, with a texture per slot made the first time the slot is used
+    RenderTexture2D chunkTextures[CHUNK_CACHE_SLOTS];
+} MazeRenderer;
+
+// Needs the window open. WALLS_SHADER falls back to WALLS_TEXTURE where shaders do not compile
+// (or on OpenGL 1.1), and both fall back to WALLS_CHUNKS when the maze is too big for a texture.
+void LoadMazeRenderer(MazeRenderer *renderer, WallMode mode);
+void UnloadMazeRenderer(MazeRenderer *renderer);
+
+// Rebuild the walls if the game has a different maze from the last call (a new maze, or a
+// restored snapshot), and build the chunks in the cells about to be drawn that are not cached.
+// Call outside BeginDrawing / EndDrawing.
+void UpdateMazeRenderer(MazeRenderer *renderer, const GameState *game, CellRange visible);
+
+// Draw the walls in the visible cells (VisibleCells, the range given to UpdateMazeRenderer),
+// in world coordinates. The texture, shader, cells and chunks are cut to that range, so the
+// cost does not grow with the maze; the mesh skips rectangles outside it but still looks at all of them.
+void DrawMazeWalls(MazeRenderer *renderer, CellRange visible);
+
+// Chunk cache hits, builds and build time so far, as a log line (WALLS_CHUNKS only)
+void LogChunkStats(const MazeRenderer *renderer);
+
+// Side of the pre-rendered circle sprite, in pixels
+#define SPRITE_SIZE 64
+
+// Entities drawn as textured quads of one pre-rendered circle, all in one rlgl batch, instead of
+// DrawCircleV tessellating each circle (36 triangles of sines and cosines) every frame
+typedef struct {
+    Texture2D circle;    // White, anti-aliased edge, tinted per draw
+    rlRenderBatch batch;
+    int capacity;        // Quads the batch holds, grown to fit the largest draw so far
+    QuadVertex *quads;   // The quads of a draw, written before they go to rlgl
+    int quadCapacity;    // Quads it holds
+} SpriteBatch;
+
+// Needs the window open
+void LoadSpriteBatch(SpriteBatch *sprites);
+void UnloadSpriteBatch(SpriteBatch *sprites);
+
+// A circle of the radius and colors[i] at each position (x[i], y[i]) that overlaps view, in world
+// coordinates. Sprites of any mix of colours go out together in one draw call.
+void DrawSprites(SpriteBatch *sprites, const float *x, const float *y, const Color *colors, int count, float radius,
+                 Rectangle view);
+
+// The maze in the fog of war, instead of DrawMazeWalls: fog over the visible cells, then only the
+// explored ones among them, paths lit where in sight and dimmed elsewhere. Unexplored cells
+// cost one bit test each.
+void DrawFogOfWar(const FieldOfView *fov, const bool *cells, CellRange visible);
+
+// The minimap and its texture, which gets only the pixels that changed
+typedef struct {
+    Minimap map;
+    Texture2D texture;
+    Color *staging;         // The changed pixels, packed for the upload
+    const SharedGrid *grid; // The maze the minimap is of, and which generation of it
+    int mazeGeneration;
+} MinimapRenderer;
+
+// Needs the window open
+void LoadMinimapRenderer(MinimapRenderer *minimap);
+void UnloadMinimapRenderer(MinimapRenderer *minimap);
+
+// Start again for a new maze, discover the cells around the player and upload the changed
+// pixels. Call outside BeginDrawing / EndDrawing.
+void UpdateMinimapRenderer(MinimapRenderer *minimap, const GameState *game);
+
+// The minimap stretched over dest with the goal, player and enemy on it: one quad and three marks
+void DrawMinimap(const MinimapRenderer *minimap, Rectangle dest, Vector2 player, Vector2 enemy);
+
+// The game scene drawn at a fraction of the window's resolution into a texture, then stretched
+// over the window in one draw, for slow GPUs. Whatever is drawn after EndScene (text, the
+// minimap) stays at full resolution.
+typedef struct {
+    RenderTexture2D target; // Only while scale is below 100
+    int scale;              // Percent of the window size along each side
+    int width, height;      // The window
+} SceneTarget;
+
+// Needs the window open
+void LoadSceneTarget(SceneTarget *scene, int width, int height, int scale);
+void UnloadSceneTarget(SceneTarget *scene);
+void SetSceneScale(SceneTarget *scene, int scale); // 10 to 100
+
+// Like BeginMode2D / EndMode2D, but into the smaller texture when scaled, which EndScene then
+// draws over the window. Call inside BeginDrawing / EndDrawing.
+void BeginScene(SceneTarget *scene, Camera2D camera);
+void EndScene(SceneTarget *scene);
+
+#endif
@@ -0,0 +1,459 @@
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_replay.h"
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_headless.h"
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define REPLAY_MAGIC "MZRP"
+#define REPLAY_VERSION 2
+#define REPLAY_HEADER_SIZE 52 // 40 in version 1, which had no hashes
+#define STREAM_MAGIC "MZHS"
+
+void BeginRecording(Replay *replay, const GameState *game) {
+    replay->seed = game->seed;
+    replay->slideWalls = game->slideWalls;
+    replay->fixedPoint = game->fixedPoint;
+    replay->speedScale = game->speedScale;
+    replay->ticks = 0;
+    replay->runs = NULL;
+    replay->runCount = 0;
+    replay->capacity = 0;
+    replay->firstMaze = game->mazeGeneration;
+    replay->mazes = 0;
+    replay->endHash = 0;
+    replay->checkpoints = NULL;
+    replay->checkpointCount = 0;
+}
+
+void RecordTick(Replay *replay, const GameState *game, GameInput input) {
+    unsigned char packed = (unsigned char)((input.keys & 15) | (input.action << 4));
+    if (replay->ticks % REPLAY_CHECKPOINT == 0) {
+        // Doubles whenever the count reaches a power of two
+        int count = replay->checkpointCount;
+        if ((count & (count - 1)) == 0) {
+            replay->checkpoints = realloc(replay->checkpoints, (count ? count * 2 : 16) * sizeof(uint64_t));
+        }
+        replay->checkpoints[replay->checkpointCount++] = game->stateHash;
+    }
+    replay->ticks++;
+    if (replay->runCount > 0 && replay->runs[replay->runCount - 1].input == packed) {
+        replay->runs[replay->runCount - 1].count++;
+        return;
+    }
+    if (replay->runCount == replay->capacity) {
+        replay->capacity = replay->capacity ? replay->capacity * 2 : 256;
+        replay->runs = realloc(replay->runs, replay->capacity * sizeof(ReplayRun));
+    }
+    replay->runs[replay->runCount].input = packed;
+    replay->runs[replay->runCount].count = 1;
+    replay->runCount++;
+}
+
+void EndRecording(Replay *replay, const GameState *game) {
+    replay->mazes = game->mazeGeneration - replay->firstMaze;
+    replay->endState[0] = game->player.x;
+    replay->endState[1] = game->player.y;
+    replay->endState[2] = game->enemy.x;
+    replay->endState[3] = game->enemy.y;
+    replay->endHash = game->stateHash;
+}
+
+void FreeReplay(Replay *replay) {
+    free(replay->runs);
+    free(replay->checkpoints);
+    replay->runs = NULL;
+    replay->checkpoints = NULL;
+    replay->checkpointCount = 0;
+    replay->runCount = 0;
+    replay->capacity = 0;
+}
+
+// Little-endian fields, so a file plays back the same on any machine
+static unsigned char *PutU32(unsigned char *out, unsigned int value) {
+    for (int i = 0; i < 4; i++) out[i] = (unsigned char)(value >> (8 * i));
+    return out + 4;
+}
+
+static const unsigned char *GetU32(const unsigned char *in, unsigned int *value) {
+    *value = in[0] | in[1] << 8 | in[2] << 16 | (unsigned int)in[3] << 24;
+    return in + 4;
+}
+
+static void WriteU64(FILE *file, uint64_t value) {
+    unsigned char bytes[8];
+    PutU32(PutU32(bytes, (unsigned int)value), (unsigned int)(value >> 32));
+    fwrite(bytes, 1, 8, file);
+}
+
+static bool ReadU64(FILE *file, uint64_t *value) {
+    unsigned char bytes[8];
+    unsigned int low, high;
+    if (fread(bytes, 1, 8, file) != 8) return false;
+    GetU32(GetU32(bytes, &low), &high);
+    *value = (uint64_t)high << 32 | low;
+    return true;
+}
+
+bool SaveReplay(const Replay *replay, const char *path) {
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) return false;
+
+    unsigned char header[REPLAY_HEADER_SIZE];
+    unsigned char *out = header;
+    memcpy(out, REPLAY_MAGIC, 4);
+    out += 4;
+    *out++ = REPLAY_VERSION;
+    out = PutU32(out, replay->seed);
+    *out++ = (unsigned char)(replay->slideWalls | replay->fixedPoint << 1);
+    *out++ = (unsigned char)replay->speedScale;
+    *out++ = 0; // Unused (was the instruction set)
+    out = PutU32(out, (unsigned int)replay->ticks);
+    out = PutU32(out, (unsigned int)replay->runCount);
+    out = PutU32(out, (unsigned int)replay->mazes);
+    for (int i = 0; i < 4; i++) {
+        unsigned int bits;
+        memcpy(&bits, &replay->endState[i], 4);
+        out = PutU32(out, bits);
+    }
+    out = PutU32(out, (unsigned int)replay->checkpointCount);
+    out = PutU32(out, (unsigned int)replay->endHash);
+    PutU32(out, (unsigned int)(replay->endHash >> 32));
+    fwrite(header, 1, sizeof(header), file);
+
+    // Most runs last under 128 ticks, so they take two bytes
+    for (int i = 0; i < replay->runCount; i++) {
+        unsigned char run[6];
+        int length = 0;
+        unsigned int count = replay->runs[i].count;
+        run[length++] = replay->runs[i].input;
+        while (count >= 128) {
+            run[length++] = (unsigned char)(count | 128);
+            count >>= 7;
+        }
+        run[length++] = (unsigned char)count;
+        fwrite(run, 1, length, file);
+    }
+    for (int i = 0; i < replay->checkpointCount; i++) WriteU64(file, replay->checkpoints[i]);
+
+    bool ok = !ferror(file);
+    fclose(file);
+    return ok;
+}
+
+bool LoadReplay(Replay *replay, const char *path) {
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) return false;
+
+    unsigned char header[REPLAY_HEADER_SIZE];
+    int version = 0;
+    if (fread(header, 1, 5, file) == 5 && memcmp(header, REPLAY_MAGIC, 4) == 0) version = header[4];
+    size_t headerSize = version == 1 ? 40 : REPLAY_HEADER_SIZE;
+    if ((version != 1 && version != REPLAY_VERSION) || fread(header + 5, 1, headerSize - 5, file) != headerSize - 5) {
+        fclose(file);
+        return false;
+    }
+
+    unsigned int ticks, runCount, mazes, checkpointCount = 0, hashLow = 0, hashHigh = 0;
+    const unsigned char *in = GetU32(header + 5, &replay->seed);
+    replay->slideWalls = *in & 1;
+    replay->fixedPoint = (*in++ & 2) != 0;
+    replay->speedScale = *in++;
+    in++; // Unused
+    in = GetU32(in, &ticks);
+    in = GetU32(in, &runCount);
+    in = GetU32(in, &mazes);
+    for (int i = 0; i < 4; i++) {
+        unsigned int bits;
+        in = GetU32(in, &bits);
+        memcpy(&replay->endState[i], &bits, 4);
+    }
+    if (version >= 2) GetU32(GetU32(GetU32(in, &checkpointCount), &hashLow), &hashHigh);
+    if (replay->fixedPoint && !FIXED_POINT_FITS) {
+        printf("Fixed point replays need a maze under 32768 pixels a side: %s\n", path);
+        fclose(file);
+        return false;
+    }
+    replay->endHash = (uint64_t)hashHigh << 32 | hashLow;
+    replay->checkpoints = NULL;
+    replay->checkpointCount = 0;
+    replay->ticks = ticks;
+    replay->mazes = mazes;
+    replay->firstMaze = 0;
+    replay->runCount = runCount;
+    replay->capacity = runCount;
+    replay->runs = malloc((runCount ? runCount : 1) * sizeof(ReplayRun));
+
+    bool ok = true;
+    for (unsigned int i = 0; i < runCount && ok; i++) {
+        int input = fgetc(file);
+        unsigned int count = 0;
+        int shift = 0, byte;
+        do {
+            byte = fgetc(file);
+            if (byte == EOF || shift > 28) {
+                ok = false;
+                break;
+            }
+            count |= (unsigned int)(byte & 127) << shift;
+            shift += 7;
+        } while (byte & 128);
+        replay->runs[i].input = (unsigned char)input;
+        replay->runs[i].count = count;
+    }
+    if (ok && checkpointCount > 0) {
+        replay->checkpoints = malloc(checkpointCount * sizeof(uint64_t));
+        replay->checkpointCount = checkpointCount;
+        for (unsigned int i = 0; i < checkpointCount && ok; i++) ok = ReadU64(file, &replay->checkpoints[i]);
+    }
+    fclose(file);
+    if (!ok) FreeReplay(replay);
+    return ok;
+}
+
+// Walks a replay one tick at a time
+typedef struct {
+    const Replay *replay;
+    int run;
+    unsigned int tick; // Within the run
+} ReplayCursor;
+
+static bool NextInput(ReplayCursor *cursor, GameInput *input) {
+    const Replay *replay = cursor->replay;
+    while (cursor->run < replay->runCount && cursor->tick >= replay->runs[cursor->run].count) {
+        cursor->run++;
+        cursor->tick = 0;
+    }
+    if (cursor->run >= replay->runCount) return false;
+    input->keys = replay->runs[cursor->run].input & 15;
+    input->action = replay->runs[cursor->run].input >> 4;
+    cursor->tick++;
+    return true;
+}
+
+// The game a replay starts from
+static void StartReplay(GameState *game, const Replay *replay) {
+    *game = (GameState){0};
+    SeedGame(game, replay->seed);
+    game->slideWalls = replay->slideWalls;
+    game->fixedPoint = replay->fixedPoint;
+    game->speedScale = replay->speedScale;
+    InitGame(game);
+}
+
+bool PlayReplay(const Replay *replay, double *seconds, long *divergedBy) {
+    GameState game;
+    StartReplay(&game, replay);
+    int firstMaze = game.mazeGeneration;
+    *divergedBy = -1;
+
+    double start = BenchSeconds();
+    for (int i = 0; i < replay->runCount; i++) {
+        GameInput input = {(unsigned char)(replay->runs[i].input & 15), (unsigned char)(replay->runs[i].input >> 4)};
+        for (unsigned int t = 0; t < replay->runs[i].count; t++) {
+            long checkpoint = game.tick / REPLAY_CHECKPOINT;
+            if (game.tick % REPLAY_CHECKPOINT == 0 && checkpoint < replay->checkpointCount &&
+                replay->checkpoints[checkpoint] != game.stateHash && *divergedBy < 0) {
+                *divergedBy = game.tick;
+            }
+            StepGame(&game, input);
+        }
+    }
+    *seconds = BenchSeconds() - start;
+
+    // Floats compared exactly: the same inputs must give the same bits
+    bool exact = game.mazeGeneration - firstMaze == replay->mazes &&
+                 game.player.x == replay->endState[0] && game.player.y == replay->endState[1] &&
+                 game.enemy.x == replay->endState[2] && game.enemy.y == replay->endState[3] &&
+                 (replay->endHash == 0 || replay->endHash == game.stateHash) && *divergedBy < 0;
+
+    CloseGame(&game);
+    return exact;
+}
+
+bool SaveHashStream(const Replay *replay, const char *path) {
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) return false;
+
+    GameState game;
+    ReplayCursor cursor = {replay, 0, 0};
+    GameInput input;
+    StartReplay(&game, replay);
+    fwrite(STREAM_MAGIC, 1, 4, file);
+    WriteU64(file, (uint64_t)replay->ticks);
+    while (NextInput(&cursor, &input)) {
+        StepGame(&game, input);
+        WriteU64(file, game.stateHash);
+    }
+
+    CloseGame(&game);
+    bool ok = !ferror(file);
+    fclose(file);
+    return ok;
+}
+
+static void PrintState(const char *label, const GameState *game) {
+    printf("  %-10s player %.9g, %.9g  enemy %.9g, %.9g  maze %d  rng %08x  started %d  over %d  hash %016llx\n",
+           label, game->player.x, game->player.y, game->enemy.x, game->enemy.y, game->mazeGeneration,
+           game->randomState, game->gamestarted, game->gameOver, (unsigned long long)game->stateHash);
+}
+
+long CheckHashStream(const Replay *replay, const char *path) {
+    FILE *file = fopen(path, "rb");
+    char magic[4];
+    uint64_t count = 0;
+    if (file == NULL || fread(magic, 1, 4, file) != 4 || memcmp(magic, STREAM_MAGIC, 4) != 0 || !ReadU64(file, &count)) {
+        printf("Cannot read hash stream: %s\n", path);
+        if (file != NULL) fclose(file);
+        return -2;
+    }
+    if (count != (uint64_t)replay->ticks) {
+        printf("hash stream %s has %llu ticks, the replay %ld; checking the ticks both have\n", path,
+               (unsigned long long)count, replay->ticks);
+    }
+    GameState game, before;
+    ReplayCursor cursor = {replay, 0, 0};
+    GameInput input;
+    uint64_t expected;
+    long diverged = -1, checked = 0;
+    StartReplay(&game, replay);
+    while (diverged < 0 && (uint64_t)checked < count && NextInput(&cursor, &input)) {
+        if (!ReadU64(file, &expected)) {
+            printf("hash stream %s ends after %ld of its %llu ticks\n", path, checked, (unsigned long long)count);
+            diverged = -2;
+            break;
+        }
+        before = game;
+        StepGame(&game, input);
+        checked++;
+        if (game.stateHash != expected) diverged = game.tick - 1;
+    }
+    // Matching as far as it goes is no proof when one side is shorter
+    if (diverged == -1 && count != (uint64_t)replay->ticks) {
+        printf("no desync in the %ld ticks both have, but the lengths differ\n", checked);
+        diverged = -2;
+    }
+    if (diverged >= 0) {
+        printf("desync at tick %ld (keys %d, action %d), hashes %016llx here, %016llx in %s\n",
+               diverged, input.keys, input.action, (unsigned long long)game.stateHash, (unsigned long long)expected, path);
+        PrintState("before", &before);
+        PrintState("after", &game);
+    }
+
+    CloseGame(&game);
+    fclose(file);
+    return diverged;
+}
+
+// Autopilot sessions the replay benchmark records and plays back, one per movement mode
+// (speeds whose step divides a cell, so the autopilot lands on cell centres)
+static const struct {
+    unsigned int seed;
+    bool slideWalls;
+    int speedScale;
+    bool fixedPoint;
+    long ticks;
+} corpus[] = {
+    {1, false, 1, false, 50000},
+    {2, false, 1, false, 50000},
+    {3, false, 1, false, 50000},
+    {4, true, 1, false, 50000},
+    {5, false, 2, false, 50000},
+    {6, false, 5, false, 50000},
+    {7, false, 1, true, 50000},
+    {8, false, 5, true, 50000},
+};
+
+static void RecordAutopilot(Replay *replay, unsigned int seed, bool slide, int speed, bool fixed, long ticks) {
+    GameState game = {0};
+    Autopilot *pilot = malloc(sizeof(Autopilot));
+    SeedGame(&game, seed);
+    game.slideWalls = slide;
+    game.speedScale = speed;
+    game.fixedPoint = fixed;
+    InitGame(&game);
+    ResetAutopilot(pilot);
+    BeginRecording(replay, &game);
+    for (long t = 0; t < ticks; t++) {
+        GameInput input = AutopilotInput(pilot, &game);
+        RecordTick(replay, &game, input);
+        StepGame(&game, input);
+    }
+    EndRecording(replay, &game);
+    CloseGame(&game);
+    free(pilot);
+}
+
+// Report one replay, returns whether it matched
+static bool ReportReplay(const char *name, const Replay *replay, long *totalTicks, double *totalSeconds) {
+    double seconds;
+    long divergedBy;
+    bool exact = PlayReplay(replay, &seconds, &divergedBy);
+    printf("replay %-24s seed %10u  %7ld ticks  %6d runs  %6d mazes  %10.0f ticks/s  %s",
+           name, replay->seed, replay->ticks, replay->runCount, replay->mazes,
+           replay->ticks / seconds, exact ? "exact" : "DIVERGED");
+    if (divergedBy >= 0) printf(" by tick %ld (see --desync)", divergedBy);
+    printf("\n");
+    *totalTicks += replay->ticks;
+    *totalSeconds += seconds;
+    return exact;
+}
+
+int RunReplays(int count, char **paths) {
+    long totalTicks = 0;
+    double totalSeconds = 0;
+    int diverged = 0;
+
+    if (count == 0) {
+        for (size_t i = 0; i < sizeof(corpus) / sizeof(corpus[0]); i++) {
+            char name[32];
+            Replay replay;
+            if (corpus[i].fixedPoint && !FIXED_POINT_FITS) continue;
+            snprintf(name, sizeof(name), "corpus-%d%s%s x%d", (int)i + 1, corpus[i].slideWalls ? " slide" : "",
+                     corpus[i].fixedPoint ? " fixed" : "", corpus[i].speedScale);
+            RecordAutopilot(&replay, corpus[i].seed, corpus[i].slideWalls, corpus[i].speedScale, corpus[i].fixedPoint,
+                            corpus[i].ticks);
+            diverged += !ReportReplay(name, &replay, &totalTicks, &totalSeconds);
+            FreeReplay(&replay);
+        }
+    }
+    for (int i = 0; i < count; i++) {
+        Replay replay;
+        if (!LoadReplay(&replay, paths[i])) {
+            printf("Cannot read replay: %s\n", paths[i]);
+            return 1;
+        }
+        diverged += !ReportReplay(paths[i], &replay, &totalTicks, &totalSeconds);
+        FreeReplay(&replay);
+    }
+
+    printf("replay total %ld ticks in %.3f s = %.0f ticks/s (%.1fx real time)\n",
+           totalTicks, totalSeconds, totalTicks / totalSeconds, totalTicks / totalSeconds / TICK_RATE);
+    return diverged ? 1 : 0;
+}
+
+int RunHashStream(const char *replayPath, const char *streamPath) {
+    Replay replay;
+    if (!LoadReplay(&replay, replayPath)) {
+        printf("Cannot read replay: %s\n", replayPath);
+        return 1;
+    }
+    bool ok = SaveHashStream(&replay, streamPath);
+    if (ok) printf("wrote %ld tick hashes to %s\n", replay.ticks, streamPath);
+    else printf("Cannot write hash stream: %s\n", streamPath);
+    FreeReplay(&replay);
+    return ok ? 0 : 1;
+}
+
+int RunDesync(const char *replayPath, const char *streamPath) {
+    Replay replay;
+    if (!LoadReplay(&replay, replayPath)) {
+        printf("Cannot read replay: %s\n", replayPath);
+        return 1;
+    }
+
+    long tick = CheckHashStream(&replay, streamPath);
+    if (tick == -1) printf("no desync in %ld ticks against %s\n", replay.ticks, streamPath);
+    FreeReplay(&replay);
+    return tick == -1 ? 0 : 1;
+}
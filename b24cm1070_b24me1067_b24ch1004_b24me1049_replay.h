@@ -0,0 +1,75 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_game.h"
+
+#define REPLAY_CHECKPOINT 60 // Ticks between the state hashes a recording keeps
+
+// Ticks in a row with the same input
+typedef struct {
+    unsigned char input; // INPUT_ keys in the low 4 bits, GameAction in the high 4
+    unsigned int count;
+} ReplayRun;
+
+// A recorded session: the seed and settings it started with, then its input run-length encoded
+typedef struct {
+    unsigned int seed;
+    bool slideWalls;
+    int speedScale;
+    bool fixedPoint;
+    long ticks;
+    ReplayRun *runs;
+    int runCount;
+    int capacity;
+
+    // Where things stood at the end, checked after every replay
+    int firstMaze;
+    int mazes;           // Mazes generated during the session
+    float endState[4];   // Player x, y and enemy x, y
+    uint64_t endHash;    // stateHash after the last tick (0 in old files)
+
+    // stateHash before tick 0, REPLAY_CHECKPOINT, 2 * REPLAY_CHECKPOINT, ...
+    uint64_t *checkpoints;
+    int checkpointCount;
+} Replay;
+
+// Start recording the game InitGame has just set up
+void BeginRecording(Replay *replay, const GameState *game);
+
+// Add one tick's input (call before StepGame with the same input)
+void RecordTick(Replay *replay, const GameState *game, GameInput input);
+
+// Note the final state, for checking replays against
+void EndRecording(Replay *replay, const GameState *game);
+
+void FreeReplay(Replay *replay);
+
+// Binary file: header, then one byte of input and a varint tick count per run, then the checkpoints
+bool SaveReplay(const Replay *replay, const char *path);
+bool LoadReplay(Replay *replay, const char *path);
+
+// Replay a session at full speed without a window. Returns true if it ended exactly where the
+// recording did, and the time it took in seconds. If a checkpoint hash differs, divergedBy is
+// the tick of the first one (the runs split up in the REPLAY_CHECKPOINT ticks before it), else -1.
+bool PlayReplay(const Replay *replay, double *seconds, long *divergedBy);
+
+// Write the stateHash after every tick of a replay (a hash stream), to compare with another build
+bool SaveHashStream(const Replay *replay, const char *path);
+
+// Desync check of the replay against a hash stream, returning the first tick whose state
+// differs (-1 if none) and printing both sides there. Returns -2 if the stream cannot be read,
+// or if it and the replay have a different number of ticks and agree on all those they share.
+long CheckHashStream(const Replay *replay, const char *path);
+
+// "--hashes replay out": write the hash stream of a replay file
+// "--desync replay stream": check it against a stream. Both return the exit code.
+int RunHashStream(const char *replayPath, const char *streamPath);
+int RunDesync(const char *replayPath, const char *streamPath);
+
+// Replay each file and report ticks per second; with no files, record and replay the standard
+// corpus of autopilot sessions (the macro benchmark). Returns the exit code.
+int RunReplays(int count, char **paths);
+
+#endif
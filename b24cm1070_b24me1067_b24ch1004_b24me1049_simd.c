@@ -0,0 +1,284 @@
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_simd.h"
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_X86
+#include <immintrin.h>
+#endif
+
+static SimdLevel simdLevel = SIMD_SCALAR;
+static bool simdDetected = false;
+
+// Best instruction set this CPU (and OS) can run
+static SimdLevel SupportedSimdLevel() {
+#ifdef SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return SIMD_AVX2;
+    if (__builtin_cpu_supports("sse2")) return SIMD_SSE;
+#endif
+    return SIMD_SCALAR;
+}
+
+SimdLevel GetSimdLevel() {
+    if (!simdDetected) {
+        simdLevel = SupportedSimdLevel();
+        simdDetected = true;
+    }
+    return simdLevel;
+}
+
+void SetSimdLevel(SimdLevel level) {
+    SimdLevel best = SupportedSimdLevel();
+    simdLevel = (level > best) ? best : level;
+    simdDetected = true;
+}
+
+const char *GetSimdLevelName(SimdLevel level) {
+    switch (level) {
+        case SIMD_AVX2: return "avx2";
+        case SIMD_SSE: return "sse";
+        default: return "scalar";
+    }
+}
+
+// Scalar chase for enemies [start, count), exact sqrt like MoveEnemy1
+static void ChaseScalar(float *ex, float *ey, const float *tx, const float *ty, int start, int count, float speed) {
+    for (int i = start; i < count; i++) {
+        float diffX = tx[i] - ex[i];
+        float diffY = ty[i] - ey[i];
+        float distance = sqrtf(diffX * diffX + diffY * diffY);
+
+        if (distance > 0) {
+            ex[i] += (diffX / distance) * speed;
+            ey[i] += (diffY / distance) * speed;
+        }
+    }
+}
+
+#ifdef SIMD_X86
+// 4 enemies at a time: rsqrtps plus one Newton-Raphson step, r = r * (1.5 - 0.5 * d2 * r * r)
+// Returns how many enemies were handled, the scalar loop does the rest
+__attribute__((target("sse")))
+static int ChaseSSE(float *ex, float *ey, const float *tx, const float *ty, int count, float speed) {
+    const __m128 vspeed = _mm_set1_ps(speed);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 threeHalves = _mm_set1_ps(1.5f);
+    const __m128 minDist2 = _mm_set1_ps(FLT_MIN);
+    int i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        __m128 x = _mm_loadu_ps(ex + i);
+        __m128 y = _mm_loadu_ps(ey + i);
+        __m128 diffX = _mm_sub_ps(_mm_loadu_ps(tx + i), x);
+        __m128 diffY = _mm_sub_ps(_mm_loadu_ps(ty + i), y);
+        __m128 dist2 = _mm_add_ps(_mm_mul_ps(diffX, diffX), _mm_mul_ps(diffY, diffY));
+
+        __m128 r = _mm_rsqrt_ps(dist2);
+        __m128 halfD2 = _mm_mul_ps(half, dist2);
+        r = _mm_mul_ps(r, _mm_sub_ps(threeHalves, _mm_mul_ps(halfD2, _mm_mul_ps(r, r))));
+
+        // Enemies already on their target stay put (rsqrt(0) is inf)
+        __m128 scale = _mm_and_ps(_mm_cmpge_ps(dist2, minDist2), _mm_mul_ps(r, vspeed));
+        _mm_storeu_ps(ex + i, _mm_add_ps(x, _mm_mul_ps(diffX, scale)));
+        _mm_storeu_ps(ey + i, _mm_add_ps(y, _mm_mul_ps(diffY, scale)));
+    }
+    return i;
+}
+
+// Same as ChaseSSE, 8 enemies at a time
+__attribute__((target("avx2")))
+static int ChaseAVX2(float *ex, float *ey, const float *tx, const float *ty, int count, float speed) {
+    const __m256 vspeed = _mm256_set1_ps(speed);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 threeHalves = _mm256_set1_ps(1.5f);
+    const __m256 minDist2 = _mm256_set1_ps(FLT_MIN);
+    int i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        __m256 x = _mm256_loadu_ps(ex + i);
+        __m256 y = _mm256_loadu_ps(ey + i);
+        __m256 diffX = _mm256_sub_ps(_mm256_loadu_ps(tx + i), x);
+        __m256 diffY = _mm256_sub_ps(_mm256_loadu_ps(ty + i), y);
+        __m256 dist2 = _mm256_add_ps(_mm256_mul_ps(diffX, diffX), _mm256_mul_ps(diffY, diffY));
+
+        __m256 r = _mm256_rsqrt_ps(dist2);
+        __m256 halfD2 = _mm256_mul_ps(half, dist2);
+        r = _mm256_mul_ps(r, _mm256_sub_ps(threeHalves, _mm256_mul_ps(halfD2, _mm256_mul_ps(r, r))));
+
+        __m256 scale = _mm256_and_ps(_mm256_cmp_ps(dist2, minDist2, _CMP_GE_OQ), _mm256_mul_ps(r, vspeed));
+        _mm256_storeu_ps(ex + i, _mm256_add_ps(x, _mm256_mul_ps(diffX, scale)));
+        _mm256_storeu_ps(ey + i, _mm256_add_ps(y, _mm256_mul_ps(diffY, scale)));
+    }
+    return i;
+}
+#endif
+
+void ChaseBatch(float *ex, float *ey, const float *tx, const float *ty, int count, float speed) {
+    int done = 0;
+#ifdef SIMD_X86
+    SimdLevel level = GetSimdLevel();
+    if (level == SIMD_AVX2) done = ChaseAVX2(ex, ey, tx, ty, count, speed);
+    else if (level == SIMD_SSE) done = ChaseSSE(ex, ey, tx, ty, count, speed);
+#endif
+    ChaseScalar(ex, ey, tx, ty, done, count, speed);
+}
+
+// Scalar wall test for agents [start, count), same sampling and truncation as CanMove
+// (indices in size_t, so grids past 2^31 cells work)
+static void CanMoveScalar(const bool *cells, int width, const float *x, const float *y, int start, int count,
+                          float cellSize, float radius, unsigned int *mask) {
+    for (int i = start; i < count; i++) {
+        size_t row = (size_t)(int)(y[i] / cellSize) * width;
+        int col = (int)(x[i] / cellSize);
+        bool ok = cells[row + (int)((x[i] + radius) / cellSize)] &&
+                  cells[row + (int)((x[i] - radius) / cellSize)] &&
+                  cells[(size_t)(int)((y[i] + radius) / cellSize) * width + col] &&
+                  cells[(size_t)(int)((y[i] - radius) / cellSize) * width + col];
+        if (ok) mask[i >> 5] |= 1u << (i & 31);
+    }
+}
+
+#ifdef SIMD_X86
+// 4 agents at a time: SIMD division and truncation to cell indices, then scalar lookups
+// (SSE has no gather)
+__attribute__((target("sse2")))
+static int CanMoveSSE(const bool *cells, int width, const float *x, const float *y, int count,
+                      float cellSize, float radius, unsigned int *mask) {
+    const __m128 vcell = _mm_set1_ps(cellSize);
+    const __m128 vradius = _mm_set1_ps(radius);
+    const __m128i vwidth = _mm_set1_epi32(width);
+    int i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        __m128 px = _mm_loadu_ps(x + i);
+        __m128 py = _mm_loadu_ps(y + i);
+        __m128i row = _mm_cvttps_epi32(_mm_div_ps(py, vcell));
+        __m128i col = _mm_cvttps_epi32(_mm_div_ps(px, vcell));
+        __m128i right = _mm_cvttps_epi32(_mm_div_ps(_mm_add_ps(px, vradius), vcell));
+        __m128i left = _mm_cvttps_epi32(_mm_div_ps(_mm_sub_ps(px, vradius), vcell));
+        __m128i down = _mm_cvttps_epi32(_mm_div_ps(_mm_add_ps(py, vradius), vcell));
+        __m128i up = _mm_cvttps_epi32(_mm_div_ps(_mm_sub_ps(py, vradius), vcell));
+
+        __m128i rowBase = _mm_madd_epi16(row, vwidth);
+        __m128i downBase = _mm_madd_epi16(down, vwidth);
+        __m128i upBase = _mm_madd_epi16(up, vwidth);
+
+        int idx[4][4];
+        _mm_storeu_si128((__m128i *)idx[0], _mm_add_epi32(rowBase, right));
+        _mm_storeu_si128((__m128i *)idx[1], _mm_add_epi32(rowBase, left));
+        _mm_storeu_si128((__m128i *)idx[2], _mm_add_epi32(downBase, col));
+        _mm_storeu_si128((__m128i *)idx[3], _mm_add_epi32(upBase, col));
+
+        unsigned int bits = 0;
+        for (int k = 0; k < 4; k++) {
+            if (cells[idx[0][k]] && cells[idx[1][k]] && cells[idx[2][k]] && cells[idx[3][k]]) bits |= 1u << k;
+        }
+        mask[i >> 5] |= bits << (i & 31);
+    }
+    return i;
+}
+
+// Gather the byte at cells[idx] for 8 agents. Each lane loads the 4 bytes ending at idx
+// (clamped to the start of the grid) so the gather never reads past the last cell.
+__attribute__((target("avx2")))
+static __m256i GatherCells(const bool *cells, __m256i idx) {
+    __m256i offset = _mm256_max_epi32(_mm256_sub_epi32(idx, _mm256_set1_epi32(3)), _mm256_setzero_si256());
+    __m256i words = _mm256_i32gather_epi32((const int *)cells, offset, 1);
+    __m256i shift = _mm256_slli_epi32(_mm256_sub_epi32(idx, offset), 3);
+    return _mm256_and_si256(_mm256_srlv_epi32(words, shift), _mm256_set1_epi32(0xFF));
+}
+
+// 8 agents at a time with AVX2 gathers into the grid
+__attribute__((target("avx2")))
+static int CanMoveAVX2(const bool *cells, int width, const float *x, const float *y, int count,
+                       float cellSize, float radius, unsigned int *mask) {
+    const __m256 vcell = _mm256_set1_ps(cellSize);
+    const __m256 vradius = _mm256_set1_ps(radius);
+    const __m256i vwidth = _mm256_set1_epi32(width);
+    const __m256i zero = _mm256_setzero_si256();
+    int i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        __m256 px = _mm256_loadu_ps(x + i);
+        __m256 py = _mm256_loadu_ps(y + i);
+        __m256i row = _mm256_cvttps_epi32(_mm256_div_ps(py, vcell));
+        __m256i col = _mm256_cvttps_epi32(_mm256_div_ps(px, vcell));
+        __m256i right = _mm256_cvttps_epi32(_mm256_div_ps(_mm256_add_ps(px, vradius), vcell));
+        __m256i left = _mm256_cvttps_epi32(_mm256_div_ps(_mm256_sub_ps(px, vradius), vcell));
+        __m256i down = _mm256_cvttps_epi32(_mm256_div_ps(_mm256_add_ps(py, vradius), vcell));
+        __m256i up = _mm256_cvttps_epi32(_mm256_div_ps(_mm256_sub_ps(py, vradius), vcell));
+        __m256i rowBase = _mm256_mullo_epi32(row, vwidth);
+
+        __m256i all = GatherCells(cells, _mm256_add_epi32(rowBase, right));
+        all = _mm256_and_si256(all, GatherCells(cells, _mm256_add_epi32(rowBase, left)));
+        all = _mm256_and_si256(all, GatherCells(cells, _mm256_add_epi32(_mm256_mullo_epi32(down, vwidth), col)));
+        all = _mm256_and_si256(all, GatherCells(cells, _mm256_add_epi32(_mm256_mullo_epi32(up, vwidth), col)));
+
+        // bool cells are 0 or 1, so a lane is non-zero only if all four samples are path
+        unsigned int bits = (unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(all, zero)));
+        mask[i >> 5] |= bits << (i & 31);
+    }
+    return i;
+}
+#endif
+
+void CanMoveBatch(const bool *cells, int width, int height, const float *x, const float *y, int count,
+                  float cellSize, float radius, unsigned int *mask) {
+    int done = 0;
+    memset(mask, 0, ((count + 31) / 32) * sizeof(unsigned int));
+#ifdef SIMD_X86
+    // SSE multiplies rows by the width 16 bits at a time (SSE2 has no pmulld), so both must fit
+    // in an int16; AVX2 multiplies and gathers in 32 bits, so the whole grid must fit in an int.
+    // Bigger grids go to the scalar loop.
+    SimdLevel level = GetSimdLevel();
+    bool fits16 = width <= 32767 && height <= 32767;
+    bool fits32 = (long long)width * height <= 0x7FFFFFFF;
+    if (level == SIMD_AVX2 && fits32) done = CanMoveAVX2(cells, width, x, y, count, cellSize, radius, mask);
+    else if (level >= SIMD_SSE && fits16) done = CanMoveSSE(cells, width, x, y, count, cellSize, radius, mask);
+#endif
+    CanMoveScalar(cells, width, x, y, done, count, cellSize, radius, mask);
+}
+
+static unsigned int LowBits(int length) {
+    return length >= 32 ? 0xFFFFFFFFu : (1u << length) - 1;
+}
+
+#ifdef SIMD_X86
+// 16 cells per movemask. The load is moved back from the end of the grid when needed, so it
+// never reads outside it, and the extra cells are shifted out.
+__attribute__((target("sse2")))
+static unsigned int PackCellBitsSSE(const bool *cells, int total, int start, int length) {
+    unsigned int bits = 0;
+    for (int done = 0; done < length; done += 16) {
+        int first = start + done;
+        int base = first + 16 <= total ? first : total - 16;
+        __m128i bytes = _mm_loadu_si128((const __m128i *)(cells + base));
+        unsigned int chunk = (unsigned int)_mm_movemask_epi8(_mm_cmpgt_epi8(bytes, _mm_setzero_si128()));
+        bits |= ((chunk >> (first - base)) & LowBits(length - done < 16 ? length - done : 16)) << done;
+    }
+    return bits;
+}
+
+// All 32 cells in one movemask
+__attribute__((target("avx2")))
+static unsigned int PackCellBitsAVX2(const bool *cells, int total, int start, int length) {
+    int base = start + 32 <= total ? start : total - 32;
+    __m256i bytes = _mm256_loadu_si256((const __m256i *)(cells + base));
+    unsigned int chunk = (unsigned int)_mm256_movemask_epi8(_mm256_cmpgt_epi8(bytes, _mm256_setzero_si256()));
+    return (chunk >> (start - base)) & LowBits(length);
+}
+#endif
+
+unsigned int PackCellBits(const bool *cells, int total, int start, int length) {
+    if (length <= 0) return 0;
+#ifdef SIMD_X86
+    SimdLevel level = GetSimdLevel();
+    if (level == SIMD_AVX2 && total >= 32) return PackCellBitsAVX2(cells, total, start, length);
+    if (level >= SIMD_SSE && total >= 16) return PackCellBitsSSE(cells, total, start, length);
+#endif
+    unsigned int bits = 0;
+    for (int i = 0; i < length; i++) bits |= (unsigned int)(cells[start + i] != 0) << i;
+    return bits;
+}
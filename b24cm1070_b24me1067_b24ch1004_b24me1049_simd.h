@@ -0,0 +1,30 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <stdbool.h>
+
+// Instruction sets the batch kernels can run on (picked at run time)
+typedef enum {
+    SIMD_SCALAR = 0,
+    SIMD_SSE,
+    SIMD_AVX2
+} SimdLevel;
+
+SimdLevel GetSimdLevel();
+void SetSimdLevel(SimdLevel level); // Clamped to what the CPU supports
+const char *GetSimdLevelName(SimdLevel level);
+
+// Move count enemies toward their targets by speed pixels each (same rule as MoveEnemy1)
+void ChaseBatch(float *ex, float *ey, const float *tx, const float *ty, int count, float speed);
+
+// Test count proposed agent positions against a width x height maze grid (row-major, true = path).
+// Like CanMove, each agent samples the four points radius away from its centre.
+// Bit i of mask (word i / 32) is set when agent i may move there.
+void CanMoveBatch(const bool *cells, int width, int height, const float *x, const float *y, int count,
+                  float cellSize, float radius, unsigned int *mask);
+
+// Bit i set when cells[start + i] is true, for up to 32 cells (start + length <= total,
+// total being the size of the whole grid, so wide loads can stay inside it)
+unsigned int PackCellBits(const bool *cells, int total, int start, int length);
+
+#endif
@@ -0,0 +1,176 @@
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_sweep.h"
+#include <math.h>
+
+#define SWEEP_SKIN 0.01f    // Pixels kept between a circle and the wall it stops at
+#define SWEEP_SLIDES 3      // Walls one move can slide along
+
+// Wall cell test, anything outside the maze counts as wall
+static bool IsWall(const bool *cells, int width, int height, int cx, int cy) {
+    if (cx < 0 || cy < 0 || cx >= width || cy >= height) return true;
+    return !cells[cy * width + cx];
+}
+
+// Ray (x, y) + t * (dx, dy) against a circle, t in [0, best)
+static bool RayCircle(float x, float y, float dx, float dy, float cx, float cy, float radius, float *t) {
+    float mx = x - cx, my = y - cy;
+    float a = dx * dx + dy * dy;
+    float b = mx * dx + my * dy;
+    float c = mx * mx + my * my - radius * radius;
+    float disc = b * b - a * c;
+    if (a == 0 || disc < 0) return false;
+    float hit = (-b - sqrtf(disc)) / a;
+    if (hit < 0 || hit >= *t) return false;
+    *t = hit;
+    return true;
+}
+
+// Circle centre moving along a ray against a wall square grown by radius (a rounded square).
+// Updates best and the normal when this wall is hit earlier.
+static void SweepWall(float x, float y, float dx, float dy, float radius,
+                      float minX, float minY, float maxX, float maxY, float *best, float *nx, float *ny) {
+    // Already touching: only a move into the wall is blocked
+    float closestX = fminf(fmaxf(x, minX), maxX);
+    float closestY = fminf(fmaxf(y, minY), maxY);
+    float awayX = x - closestX, awayY = y - closestY;
+    float dist2 = awayX * awayX + awayY * awayY;
+    if (dist2 <= radius * radius) {
+        float dist = sqrtf(dist2);
+        if (dist == 0) return; // Centre inside the wall, nothing sensible to do
+        if (awayX * dx + awayY * dy < 0) {
+            *best = 0;
+            *nx = awayX / dist;
+            *ny = awayY / dist;
+        }
+        return;
+    }
+
+    // Slab test against the square grown by radius on every side
+    float tEnter = 0, tExit = *best;
+    float faceX = 0, faceY = 0;
+    float lo[2] = {minX - radius, minY - radius};
+    float hi[2] = {maxX + radius, maxY + radius};
+    float origin[2] = {x, y};
+    float dir[2] = {dx, dy};
+    for (int axis = 0; axis < 2; axis++) {
+        if (dir[axis] == 0) {
+            if (origin[axis] < lo[axis] || origin[axis] > hi[axis]) return;
+            continue;
+        }
+        float t0 = (lo[axis] - origin[axis]) / dir[axis];
+        float t1 = (hi[axis] - origin[axis]) / dir[axis];
+        float normal = -1;
+        if (t0 > t1) {
+            float swap = t0;
+            t0 = t1;
+            t1 = swap;
+            normal = 1;
+        }
+        if (t0 > tEnter) {
+            tEnter = t0;
+            faceX = axis == 0 ? normal : 0;
+            faceY = axis == 1 ? normal : 0;
+        }
+        if (t1 < tExit) tExit = t1;
+        if (tEnter > tExit) return;
+    }
+
+    // A hit beside a corner of the square only counts if it touches the rounded corner
+    float hx = x + dx * tEnter, hy = y + dy * tEnter;
+    bool outsideX = hx < minX || hx > maxX;
+    bool outsideY = hy < minY || hy > maxY;
+    if (outsideX && outsideY) {
+        float cornerX = hx < minX ? minX : maxX;
+        float cornerY = hy < minY ? minY : maxY;
+        float t = *best;
+        if (!RayCircle(x, y, dx, dy, cornerX, cornerY, radius, &t)) return;
+        float px = x + dx * t - cornerX, py = y + dy * t - cornerY;
+        float length = sqrtf(px * px + py * py);
+        *best = t;
+        *nx = px / length;
+        *ny = py / length;
+        return;
+    }
+
+    if (tEnter < *best) {
+        *best = tEnter;
+        *nx = faceX;
+        *ny = faceY;
+    }
+}
+
+float SweepCircle(const bool *cells, int width, int height, float cellSize, float x, float y,
+                  float moveX, float moveY, float radius, float *normalX, float *normalY) {
+    int reach = (int)ceilf(radius / cellSize);
+    int cx = (int)floorf(x / cellSize);
+    int cy = (int)floorf(y / cellSize);
+    int stepX = moveX > 0 ? 1 : -1;
+    int stepY = moveY > 0 ? 1 : -1;
+
+    // DDA: t at the next column / row boundary, and t to cross a whole cell
+    float tMaxX = moveX != 0 ? (((cx + (moveX > 0)) * cellSize) - x) / moveX : INFINITY;
+    float tMaxY = moveY != 0 ? (((cy + (moveY > 0)) * cellSize) - y) / moveY : INFINITY;
+    float tDeltaX = moveX != 0 ? cellSize / fabsf(moveX) : INFINITY;
+    float tDeltaY = moveY != 0 ? cellSize / fabsf(moveY) : INFINITY;
+
+    // Cells the swept circle can touch at all, anything outside is skipped without a test
+    int minX = (int)floorf((fminf(x, x + moveX) - radius) / cellSize);
+    int maxX = (int)floorf((fmaxf(x, x + moveX) + radius) / cellSize);
+    int minY = (int)floorf((fminf(y, y + moveY) - radius) / cellSize);
+    int maxY = (int)floorf((fmaxf(y, y + moveY) + radius) / cellSize);
+
+    float best = 1;
+    float tCell = 0; // When the centre enters the current cell
+    *normalX = 0;
+    *normalY = 0;
+
+    // Walls the circle can touch while its centre is in this cell are within reach of it,
+    // so once the centre enters a cell after the best hit nothing earlier is left to find
+    while (tCell <= best) {
+        for (int wy = cy - reach; wy <= cy + reach; wy++) {
+            if (wy < minY || wy > maxY) continue;
+            for (int wx = cx - reach; wx <= cx + reach; wx++) {
+                if (wx < minX || wx > maxX || !IsWall(cells, width, height, wx, wy)) continue;
+                SweepWall(x, y, moveX, moveY, radius, wx * cellSize, wy * cellSize,
+                          (wx + 1) * cellSize, (wy + 1) * cellSize, &best, normalX, normalY);
+            }
+        }
+
+        if (tMaxX < tMaxY) {
+            tCell = tMaxX;
+            tMaxX += tDeltaX;
+            cx += stepX;
+        } else {
+            tCell = tMaxY;
+            tMaxY += tDeltaY;
+            cy += stepY;
+        }
+        if (tCell > 1) break;
+    }
+    return best;
+}
+
+void SweepMove(const bool *cells, int width, int height, float cellSize, float *x, float *y,
+               float moveX, float moveY, float radius) {
+    for (int i = 0; i < SWEEP_SLIDES; i++) {
+        float length = sqrtf(moveX * moveX + moveY * moveY);
+        if (length == 0) return;
+
+        float nx, ny;
+        float t = SweepCircle(cells, width, height, cellSize, *x, *y, moveX, moveY, radius, &nx, &ny);
+        if (t >= 1) {
+            *x += moveX;
+            *y += moveY;
+            return;
+        }
+
+        // Stop just short of the wall, then slide the rest of the move along it
+        float travel = fmaxf(t * length - SWEEP_SKIN, 0) / length;
+        *x += moveX * travel;
+        *y += moveY * travel;
+        moveX *= 1 - t;
+        moveY *= 1 - t;
+        float into = moveX * nx + moveY * ny;
+        moveX -= into * nx;
+        moveY -= into * ny;
+    }
+}
@@ -0,0 +1,17 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include <stdbool.h>
+
+// Sweep a circle from (x, y) by (moveX, moveY) through a maze grid (row-major, true = path).
+// Walks the cells under the centre with a DDA and tests the walls around each one, so no
+// move is too long to be caught. Returns the fraction of the move done before touching a
+// wall (1 if it hits nothing) and writes the wall normal at the contact.
+float SweepCircle(const bool *cells, int width, int height, float cellSize, float x, float y,
+                  float moveX, float moveY, float radius, float *normalX, float *normalY);
+
+// Move a circle with swept collision, sliding what is left of the move along each wall it hits
+void SweepMove(const bool *cells, int width, int height, float cellSize, float *x, float *y,
+               float moveX, float moveY, float radius);
+
+#endif
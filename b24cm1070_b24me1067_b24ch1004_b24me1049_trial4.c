@@ -2,395 +2,292 @@
 #include <math.h>
 #include <stdbool.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 #include "b24cm1070_b24me1067_b24ch1004_b24me1049_music.h"
-
-#define GRID_SIZE 20
-#define CELL_SIZE 40
-#define MAZE_WIDTH 19
-#define MAZE_HEIGHT 19
-#define PLAYER_SPEED 4
-int ENEMY_SPEED = 2;
-
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_bench.h"
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_game.h"
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_headless.h"
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_replay.h"
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_render.h"
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_menu.h"
+
+#define MAX_TICKS_PER_FRAME 5
+
+// Frames per second while nothing on screen changes (menus, a finished game) or the window is
+// minimised: no drawing, just input and music, which needs topping up more often than events arrive
+#define IDLE_FPS 30
+
+// Frame rate cap while the window is in the background
+#define UNFOCUSED_FPS 15
+
+// Width of the minimap in the top right corner
+#define MINIMAP_SIZE 160
+
+// The window, whatever the maze size: a bigger maze scrolls with the player, a smaller one is centred
+#define VIEW_WIDTH 760
+#define VIEW_HEIGHT 760
+
+GameState game;               // The one game the window shows
+int targetFps = 60;          // "--fps N": frame rate cap, 0 for uncapped
+double tickAccumulator = 0;  // Frame time not yet simulated
+GameAction pendingAction = ACTION_NONE; // Button clicked this frame, handled by the next tick
+const char *recordPath = "last.replay";  // "--record path": where this session's replay is saved
+// Whether to show the minimap: when the maze scrolls, or with "--minimap"
+bool showMinimap = MAZE_WIDTH * CELL_SIZE > VIEW_WIDTH || MAZE_HEIGHT * CELL_SIZE > VIEW_HEIGHT;
+int sceneScale = 100;                    // "--scale N": draw the maze at N% of the window's resolution (F2 changes it)
+bool fogOfWar = false;                   // "--fog": only show the cells the player has seen
+WallMode wallMode = WALLS_TEXTURE;       // "--walls mesh|shader|cells|chunks": how to draw the walls instead of a cached texture
+
+// What a frame shows: when it matches the last frame drawn, the screen is left as it is
 typedef struct {
-    int x, y;
-} Node;
-
-
-// Maze layout (false = wall, true = path)
-bool maze[MAZE_HEIGHT][MAZE_WIDTH];
-
-// Directions for maze generation
-static int dir[] = {0, 1, 2, 3};
-static int dx[] = {0, 0, -2, 2};
-static int dy[] = {-2, 2, 0, 0};
-
-// Function to check if a cell is valid for maze generation
-static int isvalid(int x, int y) {
-    return (x > 0 && x < MAZE_WIDTH - 1 && y > 0 && y < MAZE_HEIGHT - 1 && maze[y][x] == false);
-}
-
-// Initialize the maze to all walls
-static void initialize() {
-    for (int i = 0; i < MAZE_HEIGHT; i++) {
-        for (int j = 0; j < MAZE_WIDTH; j++) {
-            maze[i][j] = false;
-        }
-    }
-}
-
-// Shuffle directions for randomness
-static void randomdirection(int arr[], int size) {
-    for (int i = 0; i < size; ++i) {
-        int j = rand() % size;
-        int temp = arr[i];
-        arr[i] = arr[j];
-        arr[j] = temp;
-    }
-}
-
-// Maze generation algorithm
-static void SearchAndDestroy(int startX, int startY) {
-    int x = startX, y = startY;
-
-    while (1) {
-        randomdirection(dir, 4);
-        int found = 0;
-
-        for (int i = 0; i < 4; i++) {
-            int nx = x + dx[dir[i]];
-            int ny = y + dy[dir[i]];
-
-            if (isvalid(nx, ny)) {
-                maze[(y + ny) / 2][(x + nx) / 2] = true; // Remove wall
-                maze[ny][nx] = true;                    // Mark path
-                x = nx;
-                y = ny;
-                found = 1;
-                break;
-            }
-        }
-
-        if (!found) {
-            int newX = -1, newY = -1;
-
-            for (int i = 1; i < MAZE_HEIGHT; i += 2) {
-                for (int j = 1; j < MAZE_WIDTH; j += 2) {
-                    if (maze[i][j] == true) {
-                        for (int s = 0; s < 4; s++) {
-                            int nx = j + dx[s];
-                            int ny = i + dy[s];
-
-                            if (isvalid(nx, ny)) {
-                                newX = j;
-                                newY = i;
-                                break;
-                            }
-                        }
-                    }
-                    if (newX != -1) break;
-                }
-                if (newX != -1) break;
-            }
-
-            if (newX == -1) return; // Maze generation complete
-            x = newX;
-            y = newY;
-        }
-    }
+    MenuScreen screen;
+    long compositions; // Menu compositions so far, which change with the hovered button
+    int scale;
+    bool gamestarted, gameWon, gameOver;
+    int mazeGeneration;
+    Vector2 player, enemy;
+} FrameKey;
+
+static bool SameFrame(FrameKey a, FrameKey b) {
+    return a.screen == b.screen && a.compositions == b.compositions && a.scale == b.scale &&
+           a.gamestarted == b.gamestarted && a.gameWon == b.gameWon && a.gameOver == b.gameOver &&
+           a.mazeGeneration == b.mazeGeneration && a.player.x == b.player.x && a.player.y == b.player.y &&
+           a.enemy.x == b.enemy.x && a.enemy.y == b.enemy.y;
 }
 
-// Generate the maze
-void generateMaze() {
-    srand(time(NULL));
-    initialize();
-    int startX = (rand() % ((MAZE_WIDTH - 1) / 2)) * 2 + 1;
-    int startY = (rand() % ((MAZE_HEIGHT - 1) / 2)) * 2 + 1;
+// Scales F2 steps through, in percent
+static const int sceneScales[] = {100, 75, 50, 25};
+#define SCALE_STEPS 4
 
-    maze[startY][startX] = true; // Start point
-    maze[10][19] = false; // End point
-    SearchAndDestroy(startX, startY);
+// Drawn game frames and the time they took, for one scale
+typedef struct {
+    double seconds;
+    long frames;
+} FrameTimes;
+
+// The step a scale counts under: the nearest one at or above it
+static int ScaleStep(int scale) {
+    int step = 0;
+    while (step + 1 < SCALE_STEPS && sceneScales[step + 1] >= scale) step++;
+    return step;
 }
 
-// Player and enemy positions
-Vector2 player = {60, 60};
-Vector2 enemy = {CELL_SIZE * (MAZE_WIDTH - 2)- 20, CELL_SIZE * (2)- 20};
-bool gameOver = false;
-bool gameWon = false;
-bool gamestarted = false;
-bool wongame = false;
-bool showAboutPage = false;
-bool showsettingpage = false;
-bool showstartpage = false;
-bool hard = false;
-bool easy = false;
-bool medium = false;
-
-// Check if the player can move to a new position
-bool CanMove(float newX, float newY) {
-    float radius = (CELL_SIZE / 2) - 2;
-    return (maze[(int)(newY / CELL_SIZE)][(int)((newX + radius) / CELL_SIZE)] == true &&
-            maze[(int)(newY / CELL_SIZE)][(int)((newX - radius) / CELL_SIZE)] == true &&
-            maze[(int)((newY + radius) / CELL_SIZE)][(int)(newX / CELL_SIZE)] == true &&
-            maze[(int)((newY - radius) / CELL_SIZE)][(int)(newX / CELL_SIZE)] == true);
+static int NextScale(int scale) {
+    return sceneScales[(ScaleStep(scale) + 1) % SCALE_STEPS];
 }
 
-// Move the player based on input
-void MovePlayer() {
-    float newX = player.x, newY = player.y;
-    if (IsKeyDown(KEY_RIGHT) && CanMove(newX + PLAYER_SPEED, newY)) newX += PLAYER_SPEED;
-    if (IsKeyDown(KEY_LEFT) && CanMove(newX - PLAYER_SPEED, newY)) newX -= PLAYER_SPEED;
-    if (IsKeyDown(KEY_DOWN) && CanMove(newX, newY + PLAYER_SPEED)) newY += PLAYER_SPEED;
-    if (IsKeyDown(KEY_UP) && CanMove(newX, newY - PLAYER_SPEED)) newY -= PLAYER_SPEED;
-    player.x = newX;
-    player.y = newY;
+// Arrow keys held right now, as INPUT_ flags
+static int ReadKeys() {
+    int keys = 0;
+    if (IsKeyDown(KEY_RIGHT)) keys |= INPUT_RIGHT;
+    if (IsKeyDown(KEY_LEFT)) keys |= INPUT_LEFT;
+    if (IsKeyDown(KEY_DOWN)) keys |= INPUT_DOWN;
+    if (IsKeyDown(KEY_UP)) keys |= INPUT_UP;
+    return keys;
 }
 
-// Move the enemy toward the player
-void MoveEnemy1() {
-    if(medium){
-        ENEMY_SPEED = 1;
+int main(int argc, char *argv[]) {
+    // "--bench [name]" runs the benchmarks without opening a window
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        return RunBenchmarks(argc > 2 ? argv[2] : NULL);
     }
-    if(hard){
-        ENEMY_SPEED = 2;
+    // "--headless [ticks] [script]" runs the game logic at full speed without a window or audio
+    if (argc > 1 && strcmp(argv[1], "--headless") == 0) {
+        return RunHeadless(argc > 2 ? atol(argv[2]) : 0, argc > 3 ? argv[3] : NULL);
     }
-    float diffX = player.x - enemy.x;
-    float diffY = player.y - enemy.y;
-    float distance = sqrt(diffX * diffX + diffY * diffY);
-
-    if (distance > 0) {
-        enemy.x += (diffX / distance) * ENEMY_SPEED;
-        enemy.y += (diffY / distance) * ENEMY_SPEED;
+    // "--replay [files]" plays recorded sessions back at full speed (the standard corpus without files)
+    if (argc > 1 && strcmp(argv[1], "--replay") == 0) {
+        return RunReplays(argc - 2, argv + 2);
     }
-}
-
-void MoveEnemy() {
-    float diffX = player.x - enemy.x;
-    float diffY = player.y - enemy.y;
-    float distance = sqrt(diffX * diffX + diffY * diffY);
-    if (distance > 0) {
-        float moveX = (diffX / distance) * ENEMY_SPEED;
-        float moveY = (diffY / distance) * ENEMY_SPEED;
-        if (CanMove(enemy.x + moveX, enemy.y)) enemy.x += moveX;
-        if (CanMove(enemy.x, enemy.y + moveY)) enemy.y += moveY;
+    // "--hashes replay out" writes the state hash after every tick of a replay
+    if (argc > 3 && strcmp(argv[1], "--hashes") == 0) {
+        return RunHashStream(argv[2], argv[3]);
     }
-}
+    // "--desync replay stream" finds the first tick where a replay stops matching another build
+    if (argc > 3 && strcmp(argv[1], "--desync") == 0) {
+        return RunDesync(argv[2], argv[3]);
+    }
+    SeedGame(&game, (unsigned int)time(NULL));
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--slide") == 0) game.slideWalls = true;
+        if (strcmp(argv[i], "--fixed") == 0) {
+            if (!FIXED_POINT_FITS) {
+                TraceLog(LOG_ERROR, "--fixed needs a maze under 32768 pixels a side, this build's is %dx%d",
+                         CELL_SIZE * MAZE_WIDTH, CELL_SIZE * MAZE_HEIGHT);
+                return 1;
+            }
+            game.fixedPoint = true;
+        }
+        if (strcmp(argv[i], "--speed") == 0 && i + 1 < argc) game.speedScale = atoi(argv[++i]);
+        if (strcmp(argv[i], "--fps") == 0 && i + 1 < argc) targetFps = atoi(argv[++i]);
+        if (strcmp(argv[i], "--vsync") == 0) SetConfigFlags(FLAG_VSYNC_HINT);
+        if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) SeedGame(&game, (unsigned int)strtoul(argv[++i], NULL, 10));
+        if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) recordPath = argv[++i];
+        if (strcmp(argv[i], "--minimap") == 0) showMinimap = true;
+        if (strcmp(argv[i], "--fog") == 0) fogOfWar = true;
+        if (strcmp(argv[i], "--scale") == 0 && i + 1 < argc) sceneScale = atoi(argv[++i]);
+        if (strcmp(argv[i], "--walls") == 0 && i + 1 < argc) {
+            i++;
+            if (strcmp(argv[i], "mesh") == 0) wallMode = WALLS_MESH;
+            if (strcmp(argv[i], "shader") == 0) wallMode = WALLS_SHADER;
+            if (strcmp(argv[i], "cells") == 0) wallMode = WALLS_CELLS;
+            if (strcmp(argv[i], "chunks") == 0) wallMode = WALLS_CHUNKS;
+        }
+    }
+    if (game.speedScale < 1) game.speedScale = 1;
 
-int main() {
-    
     InitAudioDevice();
 
-    InitWindow(MAZE_WIDTH * CELL_SIZE, MAZE_HEIGHT * CELL_SIZE, "Maze Game");
-    SetTargetFPS(60);
+    InitWindow(VIEW_WIDTH, VIEW_HEIGHT, "Maze Game");
+    SetTargetFPS(targetFps); // Only the drawing, the simulation always runs at TICK_RATE
 
-    generateMaze(); // Generate the maze
+    InitGame(&game);
+    Replay session; // Every tick's input, so the session can be replayed exactly
+    BeginRecording(&session, &game);
     Music currentMusic = PlayMenuMusic();
 
+    MazeRenderer mazeRenderer; // The fog draws its own walls, so it gets the mode that holds and builds nothing
+    LoadMazeRenderer(&mazeRenderer, fogOfWar ? WALLS_CELLS : wallMode);
+    SpriteBatch sprites; // The player and enemy
+    LoadSpriteBatch(&sprites);
+    MinimapRenderer minimap; // Where the player has been, in a corner
+    if (showMinimap) LoadMinimapRenderer(&minimap);
+    FieldOfView fov; // What the player can see and has seen, in the fog of war
+    int fovGeneration = -1;
+    if (fogOfWar) InitFieldOfView(&fov, MAZE_WIDTH, MAZE_HEIGHT, FOV_RADIUS);
+    SceneTarget scene; // The maze and entities, at sceneScale
+    LoadSceneTarget(&scene, VIEW_WIDTH, VIEW_HEIGHT, sceneScale);
+    FrameTimes frameTimes[SCALE_STEPS] = {0};
+    bool lastDrewScene = false;
+
     Image bgImage = LoadImage("BG.png");
     Texture2D background = LoadTextureFromImage(bgImage);
     UnloadImage(bgImage);
+    MenuCache menus;
+    LoadMenus(&menus, VIEW_WIDTH, VIEW_HEIGHT, background);
+
+    double lastTime = GetTime();   // GetFrameTime only counts frames that were drawn
+    double lastDrawn = -1;         // When the screen was last drawn
+    FrameKey lastFrame = {0};
+    bool lastFocused = true, lastMinimized = false;
 
     while (!WindowShouldClose()) {
         UpdateMusicStream(currentMusic);
-        BeginDrawing();
-        ClearBackground(RAYWHITE);
 
-        if (!gamestarted && !showAboutPage && !showstartpage) {
-            DrawTexture(background,0,0,WHITE);
-            
-            Rectangle startBtn = {320, 250, 160, 50};
-            Rectangle aboutBtn = {600, 670, 160, 50};
-        
-            float roundness = 0.3f;
-            int segments = 10;
-        
-            DrawRectangleRounded(startBtn, roundness, segments, BLUE);
-            DrawRectangleRounded(aboutBtn, roundness, segments, BLUE);
-        
-            DrawText("START", 350, 260, 30, BLACK);
-            DrawText("ABOUT", 630, 680, 30, BLACK);
-        
-            if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-                Vector2 mouse = GetMousePosition();
-                if (CheckCollisionPointRec(mouse, startBtn)) {
-                    showstartpage = true;
-                    
-                    StopMusicStream(currentMusic);
-                    UnloadMusicStream(currentMusic);
-                    currentMusic = PlayRandomMusic();
-                }
-                if (CheckCollisionPointRec(mouse, aboutBtn)) {
-                    showAboutPage = true;
-                }
+        // Simulate in fixed ticks for the time the last frame took, then draw between the last two.
+        // Menu clicks from the last frame go in with the first tick, like the arrow keys.
+        int events = 0;
+        int keys = ReadKeys();
+        double now = GetTime();
+        tickAccumulator += now - lastTime;
+        lastTime = now;
+        for (int ticks = 0; tickAccumulator >= 1.0 / TICK_RATE; ticks++) {
+            if (ticks == MAX_TICKS_PER_FRAME) {
+                tickAccumulator = 0; // Too far behind (e.g. window dragged), drop the backlog
+                break;
             }
+            GameInput input = {(unsigned char)keys, (unsigned char)pendingAction};
+            RecordTick(&session, &game, input);
+            events |= StepGame(&game, input);
+            pendingAction = ACTION_NONE;
+            tickAccumulator -= 1.0 / TICK_RATE;
         }
-        else if (showAboutPage) {
-            DrawRectangle(100, 100, 600, 400, LIGHTGRAY);  // Background box
-            DrawText("ABOUT THIS GAME", 260, 150, 30, DARKBLUE);
-            DrawText("Created by......", 300, 200, 20, BLACK);
-            DrawText("Tushar Verma", 220, 320, 20, PINK);
-            DrawText("Abhishek Sonparote", 220, 280, 20, GREEN);
-            DrawText("Samyag Kothari", 220, 240, 20, RED);
-            DrawText("Mrigank Sharma", 220, 360, 20, BLUE);
-        
-            Rectangle exitBtn = {320, 500, 160, 50};
-            float roundness = 0.3f;
-            int segments = 10;
-        
-            DrawRectangleRounded(exitBtn, roundness, segments, BLUE);
-            DrawText("EXIT", 360, 510, 30, BLACK);
-        
-            if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-                Vector2 mouse = GetMousePosition();
-                if (CheckCollisionPointRec(mouse, exitBtn)) {
-                    showAboutPage = false;  // Return to main menu
-                }
-            }
+        float alpha = (float)(tickAccumulator * TICK_RATE);
+        Vector2 drawPlayer = {game.prevPlayer.x + (game.player.x - game.prevPlayer.x) * alpha, game.prevPlayer.y + (game.player.y - game.prevPlayer.y) * alpha};
+        Vector2 drawEnemy = {game.prevEnemy.x + (game.enemy.x - game.prevEnemy.x) * alpha, game.prevEnemy.y + (game.enemy.y - game.prevEnemy.y) * alpha};
+
+        // Follow the player, and draw only the cells and entities in view (no cells behind the menus)
+        Camera2D camera = FollowCamera(drawPlayer, VIEW_WIDTH, VIEW_HEIGHT, MAZE_WIDTH * CELL_SIZE, MAZE_HEIGHT * CELL_SIZE);
+        Rectangle view = CameraView(camera, VIEW_WIDTH, VIEW_HEIGHT);
+        CellRange visible = {0, 0, -1, -1};
+        if (game.gamestarted) visible = VisibleCells(view, CELL_SIZE, MAZE_WIDTH, MAZE_HEIGHT);
+        // Only redraws walls for a new maze or new chunks in view
+        if (!fogOfWar) UpdateMazeRenderer(&mazeRenderer, &game, visible);
+        if (showMinimap && game.gamestarted) UpdateMinimapRenderer(&minimap, &game); // Only uploads newly seen pixels
+        if (fogOfWar && game.gamestarted) {
+            if (game.mazeGeneration != fovGeneration) ClearFieldOfView(&fov);
+            fovGeneration = game.mazeGeneration;
+            UpdateFieldOfView(&fov, game.grid->cells, (int)(game.player.x / CELL_SIZE), (int)(game.player.y / CELL_SIZE));
+        }
+        MenuScreen screen = MenuScreenOf(&game);
+        GameAction clicked = UpdateMenu(&menus, screen); // Only redraws the menu when the hovered button changes
+        if (clicked != ACTION_NONE) pendingAction = clicked;
+        if (screen == MENU_NONE && (game.gameWon || game.gameOver) && IsKeyPressed(KEY_R)) pendingAction = ACTION_RESTART;
+        if (IsKeyPressed(KEY_F2)) SetSceneScale(&scene, NextScale(scene.scale));
+
+        // A new maze or a new game gets a new track
+        if (events & EVENT_NEW_TRACK) {
+            StopMusicStream(currentMusic);
+            UnloadMusicStream(currentMusic);
+            currentMusic = PlayRandomMusic();
         }
 
-        else if (showstartpage) {
-            DrawRectangle(95, 100, 600, 600, LIGHTGRAY);  // Background box
-            DrawText("WHAT DO YOU WANT\n TO PLAY (MODE)", 300, 200, 30, BLACK);
-
-            Rectangle hardBtn = {320, 300, 160, 50};
-            Rectangle mediumBtn = {310, 400, 180, 50};
-            Rectangle easyBtn = {320, 500, 160, 50};
-
-            float roundness = 0.3f;
-            int segments = 10;
-
-            DrawRectangleRounded(hardBtn, roundness, segments, BLUE);
-            DrawRectangleRounded(mediumBtn, roundness, segments, BLUE);
-            DrawRectangleRounded(easyBtn, roundness, segments, BLUE);
-
-            DrawText("HARD", 360, 310, 30, PINK);
-            DrawText("MEDIUM", 340, 410, 30, GREEN);
-            DrawText("EASY", 360, 510, 30, RED);
-
-            if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-                Vector2 mouse = GetMousePosition();
-                if (CheckCollisionPointRec(mouse, easyBtn)) {
-                    easy = true;
-                    gamestarted = true;
-                    player.x = 60;
-                    player.y = 60;
-                    enemy.x = CELL_SIZE * (MAZE_WIDTH - 2) - 20;
-                    enemy.y = CELL_SIZE * (2) - 20;
-                    gameOver = false;
-                    generateMaze();
-                    showstartpage = false;
-                }
-                if (CheckCollisionPointRec(mouse, mediumBtn)) {
-                    medium = true;
-                    gamestarted = true;
-                    player.x = 60;
-                    player.y = 60;
-                    enemy.x = CELL_SIZE * (MAZE_WIDTH - 2) - 20;
-                    enemy.y = CELL_SIZE * (2) - 20;
-                    gameOver = false;
-                    generateMaze();
-                    showstartpage = false;
-                }
-                if (CheckCollisionPointRec(mouse, hardBtn)) {
-                    hard = true;
-                    gamestarted = true;
-                    player.x = 60;
-                    player.y = 60;
-                    enemy.x = CELL_SIZE * (MAZE_WIDTH - 2) - 20;
-                    enemy.y = CELL_SIZE * (2) - 20;
-                    gameOver = false;
-                    generateMaze();
-                    showstartpage = false;
-                }
-            }
-
-            Rectangle exitBtn = {320, 600, 160, 50};
-        
-            DrawRectangleRounded(exitBtn, roundness, segments, BLUE);
-            DrawText("EXIT", 360, 610, 30, BLACK);
-        
-            if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-                Vector2 mouse = GetMousePosition();
-                if (CheckCollisionPointRec(mouse, exitBtn)) {
-                    gamestarted = false;
-                    showstartpage = false;
-                }
-            }
+        // Slow down in the background, and leave the screen alone while it would not change. Gaining or
+        // losing focus redraws, and so does a second without drawing, in case the window was covered.
+        bool focused = IsWindowFocused(), minimized = IsWindowMinimized();
+        if (focused != lastFocused) {
+            bool slower = targetFps == 0 || targetFps > UNFOCUSED_FPS;
+            SetTargetFPS(!focused && slower ? UNFOCUSED_FPS : targetFps);
+        }
+        FrameKey frame = {screen, menus.compositions, scene.scale, game.gamestarted, game.gameWon, game.gameOver,
+                          game.mazeGeneration, drawPlayer, drawEnemy};
+        bool unchanged = SameFrame(frame, lastFrame) && focused == lastFocused && minimized == lastMinimized &&
+                         now - lastDrawn < 1;
+        lastFocused = focused;
+        lastMinimized = minimized;
+        if (minimized || unchanged) {
+            PollInputEvents(); // EndDrawing does this on drawn frames
+            WaitTime(1.0 / IDLE_FPS);
+            lastDrewScene = false;
+            continue;
         }
+        // Time from one drawn game frame to the next, per scale
+        if (lastDrewScene && screen == MENU_NONE) {
+            FrameTimes *times = &frameTimes[ScaleStep(scene.scale)];
+            times->seconds += now - lastDrawn;
+            times->frames++;
+        }
+        lastDrewScene = screen == MENU_NONE;
+        lastFrame = frame;
+        lastDrawn = now;
 
-        else if (gamestarted){
-            if (!gameOver && !gameWon) {
-                MovePlayer();
-                if (easy) {
-                    MoveEnemy();
-                }
-                if (medium) {
-                    MoveEnemy1();
-                }
-                if (hard) {
-                    MoveEnemy1();
-                }
-            }
+        BeginDrawing();
+        ClearBackground(RAYWHITE);
 
-            // Draw the maze
-            for (int y = 0; y < MAZE_HEIGHT; y++) {
-                for (int x = 0; x < MAZE_WIDTH; x++) {
-                    if (maze[y][x] == false) {
-                        DrawRectangle(x * CELL_SIZE, y * CELL_SIZE, CELL_SIZE, CELL_SIZE, BLACK);
-                    }
-                }
+        if (screen != MENU_NONE) {
+            DrawMenu(&menus, screen);
+        }
+        else if (game.gamestarted){
+            Rectangle goal = {GOAL_X - CELL_SIZE / 2, GOAL_Y - CELL_SIZE / 2, CELL_SIZE, CELL_SIZE};
+            BeginScene(&scene, camera);
+            bool enemyShown = true, goalShown = CheckCollisionRecs(goal, view);
+            if (fogOfWar) {
+                DrawFogOfWar(&fov, game.grid->cells, visible);
+                enemyShown = CellInSight(&fov, (int)(game.enemy.x / CELL_SIZE), (int)(game.enemy.y / CELL_SIZE));
+                goalShown = goalShown && CellExplored(&fov, GOAL_X / CELL_SIZE, GOAL_Y / CELL_SIZE);
+            } else {
+                DrawMazeWalls(&mazeRenderer, visible);
             }
-
-            DrawCircleV(player, CELL_SIZE / 2, BLUE);
-            DrawCircleV(enemy, CELL_SIZE / 2, RED);
-            DrawRectangle(700-20, 700-20, 40, 40, GREEN);
-
-            if (player.x == (700) && player.y == (700)) wongame = true;
-
-            if(wongame){
-                player.x = 60;
-                player.y = 60;
-                enemy.x = CELL_SIZE * (MAZE_WIDTH - 2) - 20;
-                enemy.y = CELL_SIZE * (2) - 20;
-                wongame = false;
-
-                StopMusicStream(currentMusic);
-                UnloadMusicStream(currentMusic);
-                currentMusic = PlayRandomMusic();
-                generateMaze(); // Regenerate the maze
+            // The player and (unless it is hidden in the fog) the enemy, in one batch
+            float spriteX[2] = {drawPlayer.x, drawEnemy.x}, spriteY[2] = {drawPlayer.y, drawEnemy.y};
+            Color spriteColors[2] = {BLUE, RED};
+            DrawSprites(&sprites, spriteX, spriteY, spriteColors, enemyShown ? 2 : 1, CELL_SIZE / 2, view);
+            if (goalShown) DrawRectangleRec(goal, GREEN);
+            EndScene(&scene); // Text and the minimap after this are at full resolution
+            if (showMinimap) {
+                const Minimap *map = &minimap.map;
+                float height = MINIMAP_SIZE * (float)map->pixelsHigh / map->pixelsWide;
+                Rectangle corner = {VIEW_WIDTH - MINIMAP_SIZE - 10, 10, MINIMAP_SIZE, height};
+                DrawMinimap(&minimap, corner, drawPlayer, drawEnemy);
             }
 
-            if (CheckCollisionCircles(player, CELL_SIZE / 2, enemy, CELL_SIZE / 2)) gameOver = true;
-
-            if (gameWon) {
+            if (game.gameWon) {
                 DrawText("YOU WIN!", 350, 400, 40, GREEN);
                 DrawText("Press R to Restart", 200, 450, 40, PURPLE);
-                if (IsKeyPressed(KEY_R)) {
-                    player.x = 60;
-                    player.y = 60;
-                    enemy.x = CELL_SIZE * (MAZE_WIDTH - 2) - 20;
-                    enemy.y = CELL_SIZE * (2) - 20;
-                    gameWon = false;
-                    
-                    StopMusicStream(currentMusic);
-                    UnloadMusicStream(currentMusic);
-                    currentMusic = PlayRandomMusic();
-
-                    generateMaze(); // Regenerate the maze
-                }
-            } else if (gameOver) {
+            } else if (game.gameOver) {
                 DrawText("Game Over!", 300, 300, 40, RED);
                 DrawText("Press R to Restart", 200, 450, 40, GREEN);
-                if (IsKeyPressed(KEY_R)) {
-                    hard = false;
-                    easy = false;
-                    medium = false;
-                    showstartpage = true;
-                    
-                    StopMusicStream(currentMusic);
-                    UnloadMusicStream(currentMusic);
-                    currentMusic = PlayRandomMusic();
-                }
             }
         }
 
@@ -400,7 +297,24 @@ int main() {
     UnloadMusicStream(currentMusic);
     CloseAudioDevice();
 
+    UnloadMenus(&menus);
     UnloadTexture(background);
+    LogChunkStats(&mazeRenderer);
+    UnloadMazeRenderer(&mazeRenderer);
+    UnloadSpriteBatch(&sprites);
+    if (showMinimap) UnloadMinimapRenderer(&minimap);
+    if (fogOfWar) FreeFieldOfView(&fov);
+    UnloadSceneTarget(&scene);
+    for (int i = 0; i < SCALE_STEPS; i++) {
+        if (frameTimes[i].frames == 0) continue;
+        double average = frameTimes[i].seconds / frameTimes[i].frames;
+        TraceLog(LOG_INFO, "Scale %3d%%: %ld frames, %.3f ms each (%.0f fps)", sceneScales[i], frameTimes[i].frames,
+                 average * 1e3, 1 / average);
+    }
+    EndRecording(&session, &game);
+    if (!SaveReplay(&session, recordPath)) TraceLog(LOG_WARNING, "Could not save replay to %s", recordPath);
+    FreeReplay(&session);
+    CloseGame(&game);
     CloseWindow();
     return 0;
 }
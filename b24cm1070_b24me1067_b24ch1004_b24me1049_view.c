@@ -0,0 +1,40 @@
+#include "b24cm1070_b24me1067_b24ch1004_b24me1049_view.h"
+#include <math.h>
+
+// Where to look along one axis
+static float FollowAxis(float target, float view, float world) {
+    if (world <= view) return world / 2;
+    return fminf(fmaxf(target, view / 2), world - view / 2);
+}
+
+Camera2D FollowCamera(Vector2 target, float viewWidth, float viewHeight, float worldWidth, float worldHeight) {
+    Camera2D camera = {0};
+    camera.offset = (Vector2){viewWidth / 2, viewHeight / 2};
+    camera.target = (Vector2){FollowAxis(target.x, viewWidth, worldWidth), FollowAxis(target.y, viewHeight, worldHeight)};
+    camera.zoom = 1;
+    return camera;
+}
+
+Rectangle CameraView(Camera2D camera, float viewWidth, float viewHeight) {
+    float zoom = camera.zoom > 0 ? camera.zoom : 1;
+    return (Rectangle){camera.target.x - camera.offset.x / zoom, camera.target.y - camera.offset.y / zoom,
+                       viewWidth / zoom, viewHeight / zoom};
+}
+
+static int ClampCell(float v, float cellSize, int limit) {
+    int cell = (int)floorf(v / cellSize);
+    return cell < 0 ? 0 : cell >= limit ? limit - 1 : cell;
+}
+
+CellRange VisibleCells(Rectangle view, float cellSize, int width, int height) {
+    CellRange range = {0, 0, -1, -1};
+    if (view.x >= width * cellSize || view.y >= height * cellSize || view.x + view.width <= 0 || view.y + view.height <= 0) {
+        return range;
+    }
+    // A cell whose far edge only touches the view's edge is not in it
+    range.minX = ClampCell(view.x, cellSize, width);
+    range.minY = ClampCell(view.y, cellSize, height);
+    range.maxX = ClampCell(nextafterf(view.x + view.width, -INFINITY), cellSize, width);
+    range.maxY = ClampCell(nextafterf(view.y + view.height, -INFINITY), cellSize, height);
+    return range;
+}
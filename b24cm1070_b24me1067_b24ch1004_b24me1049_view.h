@@ -0,0 +1,25 @@
+#ifndef VIEW_H
+#define VIEW_H
+
+#include "raylib.h" // Only for Camera2D and Rectangle, no raylib calls
+
+// Scrolling view of a maze bigger than the window: a Camera2D that follows a point, and the
+// range of cells it can see, so drawing visits just those (the same work at any maze size)
+
+// Cells [minX, maxX] x [minY, maxY], empty when maxX < minX
+typedef struct {
+    int minX, minY;
+    int maxX, maxY;
+} CellRange;
+
+// A camera centred on target, held back at the edges so it never shows outside the world
+// (centred on the world along an axis where the world is smaller than the view)
+Camera2D FollowCamera(Vector2 target, float viewWidth, float viewHeight, float worldWidth, float worldHeight);
+
+// The part of the world a camera shows in a view of this size (no rotation)
+Rectangle CameraView(Camera2D camera, float viewWidth, float viewHeight);
+
+// Cells of a width x height grid that overlap a world rectangle
+CellRange VisibleCells(Rectangle view, float cellSize, int width, int height);
+
+#endif